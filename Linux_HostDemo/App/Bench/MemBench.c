@@ -0,0 +1,180 @@
+/*********************************************************************************************************
+* ģƣMemBench.c
+* ժ    ҪƬڴϵķ/ͷźʱ׼
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260219
+*     ݣ
+*          1ȷ 2N Сٸһͷһڴǰ N ޷ϲСп
+*          2ֱ N = 0/16/64/256 ʱŲСп OSMalloc  OSFree ƽʱ
+*          3 OS_CFG_MEM_TLSF_EN ѡ
+*             make bench                 ʹ OS/os_cfg.h е
+*             make bench MEM_TLSF=0      ״䵥
+*             make bench MEM_TLSF=1      (TLSF)
+* ע    ⣺
+*          1ֱӵڴӿڣõǺٽĽӿڿ
+*          2״ʱÿη䶼ҪȫƬǷͷɿͷеǰֱӺϲƬ޹
+*          3OSMalloc/OSFree ںдڹж״ִ̬УʱֱӼжӳ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+#include <time.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define BENCH_FRAG_MAX   256     //Сп
+#define BENCH_FRAG_SIZE  16      //ƬСС(ֽ)
+#define BENCH_ROUNDS     20000   //ÿƬ²ķ/ͷŴ
+#define BENCH_REQ_MIN    24      //С(С ܸƬ)
+#define BENCH_REQ_MAX    256     //
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void* s_arrFragPtr[BENCH_FRAG_MAX * 2];  //ƬʱС
+static u32   s_iRandSeed = 1;                   //α(ֺ֤һ)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static u32  BenchRand(void);                 //ͬα
+static u64  BenchNowNs(void);                //ʱ(ns)
+static void BenchRun(u32 fragNum);           //һƬµķ/ͷźʱ
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣBenchRand
+* ܣαС
+* void
+* void
+*   ֵBENCH_REQ_MIN ~ BENCH_REQ_MAX
+* ڣ20260219
+* ע    ⣺
+*********************************************************************************************************/
+static u32 BenchRand(void)
+{
+	s_iRandSeed = s_iRandSeed * 1103515245 + 12345;
+	return (s_iRandSeed >> 16) % (BENCH_REQ_MAX - BENCH_REQ_MIN + 1) + BENCH_REQ_MIN;
+}
+
+/*********************************************************************************************************
+* ƣBenchNowNs
+* ܣȡʱ
+* void
+* void
+*   ֵʱ
+* ڣ20260219
+* ע    ⣺
+*********************************************************************************************************/
+static u64 BenchNowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/*********************************************************************************************************
+* ƣBenchRun
+* ܣ fragNum Сп飬ٷ/ͷһϴĿ鲢ʱ
+* fragNum: Сп
+* void
+*   ֵvoid
+* ڣ20260219
+* ע    ⣺ͷźĩβĴпϲ ÿֿʼʱڴص״ͬ  OSMemCheck ͷ
+*********************************************************************************************************/
+static void BenchRun(u32 fragNum)
+{
+	u32 i;
+	u32 size;
+	void *ptr;
+	u64 start;
+	u64 cost;
+	u64 mallocTotal;
+	u64 mallocWorst;
+	u64 freeTotal;
+	u64 freeWorst;
+
+	s_iRandSeed = 1;
+	OSInitMemory();
+
+	for(i = 0; i < fragNum * 2; i++)
+	{
+		s_arrFragPtr[i] = OSMalloc(BENCH_FRAG_SIZE);
+	}
+	for(i = 0; i < fragNum * 2; i += 2)
+	{
+		OSFree(s_arrFragPtr[i]);
+	}
+
+	mallocTotal = 0;
+	mallocWorst = 0;
+	freeTotal   = 0;
+	freeWorst   = 0;
+	for(i = 0; i < BENCH_ROUNDS; i++)
+	{
+		size = BenchRand();
+
+		start = BenchNowNs();
+		ptr = OSMalloc(size);
+		cost = BenchNowNs() - start;
+		mallocTotal += cost;
+		if(cost > mallocWorst)
+		{
+			mallocWorst = cost;
+		}
+
+		start = BenchNowNs();
+		OSFree(ptr);
+		cost = BenchNowNs() - start;
+		freeTotal += cost;
+		if(cost > freeWorst)
+		{
+			freeWorst = cost;
+		}
+	}
+
+	printf("[MemBench] Fragments = %3u, Malloc Avg = %4llu ns, Max = %6llu ns, Free Avg = %4llu ns, Max = %6llu ns\r\n",
+	       fragNum, (unsigned long long)(mallocTotal / BENCH_ROUNDS), (unsigned long long)mallocWorst,
+	       (unsigned long long)(freeTotal / BENCH_ROUNDS), (unsigned long long)freeWorst);
+	if(OSMemCheck() == 0)
+	{
+		printf("[MemBench] Heap is corrupted with %u fragments!\r\n", fragNum);
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣmain
+* ܣ
+* void
+* void
+*   ֵint
+* ڣ20260219
+* ע    ⣺Max ʱӶȡȶ  Avg ԱΪ
+*********************************************************************************************************/
+int main(void)
+{
+	printf("[MemBench] Backend = %s\r\n", OS_CFG_MEM_TLSF_EN ? "TLSF" : "First-Fit");
+
+	BenchRun(0);
+	BenchRun(16);
+	BenchRun(64);
+	BenchRun(256);
+
+	return 0;
+}
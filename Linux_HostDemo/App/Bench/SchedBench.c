@@ -0,0 +1,138 @@
+/*********************************************************************************************************
+* ģƣSchedBench.c
+* ժ    Ҫн·ʱ׼
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260215
+*     ݣ
+*          1ڳʱ״̬ڼûʱһ SysTick_Handler ƽʱ
+*          2Ĵʱ顢ʱƬԼ OSIntExit пܴ PendSV
+* ע    ⣺
+*          1ֱе SysTick_Handlerʱڷ̬
+*             OSIntExit  PendSV ִУ񲻱ʱл
+*          2ʱĿϿ DWT CYCCNT  SysTick_Handler ǰȡõ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+#include <time.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define BENCH_TASK_NUM   8          //ʱ״̬
+#define BENCH_STK_SIZE   4096       //ջС(u32)
+#define BENCH_DELAY      100000000  //ʱ(ڼ䲻ᵽ)
+#define BENCH_WARMUP     1000       //ԤȽ
+#define BENCH_TICKS      2000000    //
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static OS_TASK_HANDLE s_arrBenchTask[BENCH_TASK_NUM];                 //ʱ
+static u32            s_arrBenchStack[BENCH_TASK_NUM][BENCH_STK_SIZE];  //ʱջ
+extern OS_TASK_HANDLE* g_pCurrentTask;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void BenchTask(void);     //ʱ()
+static u64  BenchNowNs(void);    //ʱ(ns)
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣBenchTask
+* ܣʱ
+* void
+* void
+*   ֵvoid
+* ڣ20260215
+* ע    ⣺ úᱻִ
+*********************************************************************************************************/
+static void BenchTask(void)
+{
+	while(1)
+	{
+		OSDelay(1000);
+	}
+}
+
+/*********************************************************************************************************
+* ƣBenchNowNs
+* ܣȡʱ
+* void
+* void
+*   ֵʱ
+* ڣ20260215
+* ע    ⣺
+*********************************************************************************************************/
+static u64 BenchNowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣmain
+* ܣ
+* void
+* void
+*   ֵint
+* ڣ20260215
+* ע    ⣺ʱȡƽ ÿĶһʱӵĿ
+*********************************************************************************************************/
+int main(void)
+{
+	u32 i;
+	u64 start;
+	u64 cost;
+
+	InitCasyOS();
+
+	for(i = 0; i < BENCH_TASK_NUM; i++)
+	{
+		OSRegister(&s_arrBenchTask[i], BenchTask, "BenchTask", 10 + i, s_arrBenchStack[i], BENCH_STK_SIZE, 0, 0);
+
+		//ֱתʱ״̬ ൱ѵ OSDelay(BENCH_DELAY)
+		OS_ENTER_CRITICAL();
+		OS_RdyTaskRemove(&s_arrBenchTask[i]);
+		s_arrBenchTask[i].state = OS_TASK_DELAY;
+		OS_TickTaskInsert(&s_arrBenchTask[i], BENCH_DELAY);
+		OS_EXIT_CRITICAL();
+	}
+
+	OS_UpdateCurrentTask();	//ǰΪȼ ڼ䱣ֲ
+
+	for(i = 0; i < BENCH_WARMUP; i++)
+	{
+		SysTick_Handler();
+	}
+
+	start = BenchNowNs();
+	for(i = 0; i < BENCH_TICKS; i++)
+	{
+		SysTick_Handler();
+	}
+	cost = BenchNowNs() - start;
+
+	printf("[SchedBench] Current = %s, Delayed = %u\r\n", g_pCurrentTask->taskName, BENCH_TASK_NUM);
+	printf("[SchedBench] Idle Tick Avg = %llu.%02llu ns (%u ticks)\r\n",
+	       (unsigned long long)(cost / BENCH_TICKS), (unsigned long long)(cost * 100 / BENCH_TICKS % 100), BENCH_TICKS);
+
+	return 0;
+}
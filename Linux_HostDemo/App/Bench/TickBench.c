@@ -0,0 +1,162 @@
+/*********************************************************************************************************
+* ģƣTickBench.c
+* ժ    Ҫʱбʱ׼
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260209
+*     ݣ
+*          1ֱ 8/64/512 ʱ״̬ʱ OS_TickTaskInsert ƽʱ
+*          2ʱб OS_CFG_TICK_WHEEL_EN ѡ
+*             make bench                 ʹ OS/os_cfg.h е
+*             make bench TICK_WHEEL=0    
+*             make bench TICK_WHEEL=1    ϣʱ
+* ע    ⣺
+*          1ֱӵںʱбӿڣõǴݽṹ
+*          2OS_TickTaskInsert ںдڹж״ִ̬УʱֱӼжӳ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+#include <string.h>
+#include <time.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define BENCH_TASK_MAX   512     //ͬʱʱ
+#define BENCH_ROUNDS     20000   //ÿ²Ĳ
+#define BENCH_DELAY_MAX  5000    //ʱ(tick)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static OS_TASK_HANDLE s_arrBenchTask[BENCH_TASK_MAX];  //ʱ״̬
+static OS_TASK_HANDLE s_structProbe;                   //ʱ
+static u32 s_iRandSeed = 1;                            //α(ֺ֤һ)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static u32  BenchRand(void);                 //ͬα
+static u64  BenchNowNs(void);                //ʱ(ns)
+static void BenchRun(u32 taskNum);           //һµĲʱ
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣBenchRand
+* ܣαʱ
+* void
+* void
+*   ֵ1 ~ BENCH_DELAY_MAX
+* ڣ20260209
+* ע    ⣺
+*********************************************************************************************************/
+static u32 BenchRand(void)
+{
+	s_iRandSeed = s_iRandSeed * 1103515245 + 12345;
+	return (s_iRandSeed >> 16) % BENCH_DELAY_MAX + 1;
+}
+
+/*********************************************************************************************************
+* ƣBenchNowNs
+* ܣȡʱ
+* void
+* void
+*   ֵʱ
+* ڣ20260209
+* ע    ⣺
+*********************************************************************************************************/
+static u64 BenchNowNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+/*********************************************************************************************************
+* ƣBenchRun
+* ܣ taskNum ʱбٷ/ɾ̽񲢼ʱ
+* taskNum: ʱ״̬
+* void
+*   ֵvoid
+* ڣ20260209
+* ע    ⣺̽ʱ [1, BENCH_DELAY_MAX]  ģʽƽһĽ
+*********************************************************************************************************/
+static void BenchRun(u32 taskNum)
+{
+	u32 i;
+	u32 delay;
+	u64 start;
+	u64 cost;
+	u64 total;
+	u64 worst;
+
+	memset(s_arrBenchTask, 0, sizeof(s_arrBenchTask));
+	memset(&s_structProbe, 0, sizeof(s_structProbe));
+	s_iRandSeed = 1;
+	OS_TickListInit();
+
+	for(i = 0; i < taskNum; i++)
+	{
+		delay = BenchRand();
+		s_arrBenchTask[i].tick = delay;
+		OS_TickTaskInsert(&s_arrBenchTask[i], delay);
+	}
+
+	total = 0;
+	worst = 0;
+	for(i = 0; i < BENCH_ROUNDS; i++)
+	{
+		delay = BenchRand();
+		s_structProbe.tick = delay;
+
+		start = BenchNowNs();
+		OS_TickTaskInsert(&s_structProbe, delay);
+		cost = BenchNowNs() - start;
+
+		OS_TickTaskRemove(&s_structProbe);
+
+		total += cost;
+		if(cost > worst)
+		{
+			worst = cost;
+		}
+	}
+
+	printf("[TickBench] Delayed = %3u, Insert Avg = %4llu ns, Max = %6llu ns\r\n",
+	       taskNum, (unsigned long long)(total / BENCH_ROUNDS), (unsigned long long)worst);
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣmain
+* ܣ
+* void
+* void
+*   ֵint
+* ڣ20260209
+* ע    ⣺Max ʱӶȡȶ  Avg ԱΪ
+*********************************************************************************************************/
+int main(void)
+{
+	printf("[TickBench] Backend = %s\r\n", OS_CFG_TICK_WHEEL_EN ? "Timing Wheel" : "Delta List");
+
+	BenchRun(8);
+	BenchRun(64);
+	BenchRun(512);
+
+	return 0;
+}
@@ -0,0 +1,874 @@
+/*********************************************************************************************************
+* ģƣMain.c
+* ժ    ҪLinux ʾCasyOS ں̷ͨʽ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260202
+*     ݣ
+*           (1)  GD32F303ZET6_KeilFullDemo ĲһһӦLED/ź/Ϣ//־/ڴ棩
+*           (2) ڽж SIGUSR1 жϴ
+*           (3)  RUN_TIME_MS ɼӡͳϢ˳
+*           (4) ͬȼѭʾʱƬתRRTask2 ʱƬΪ RRTask1 һ
+*           (5) PIHigh/PIMed/PILow 쾭ȼתͳƸȼȡʱ
+*           (6) LED ˸ʱɣٸռһջ
+*           (7) ˳ǰӡʱ䡢CPUռCPUأԼջʹ
+*           (8) ׷ڵں¼¼иļʱдļ trace_decode 
+*           (9) 洮жֻǼӺź/Ϣ/־ͷӺ
+*           (10) 洮жͬʱ֪ͨ(һ)ֱӻ NotifyTaskӺ
+*           (11) SpawnTask ͬһ TCB ջעʱ񣬹һϢֱ return ɾ
+*           (12) ControlTask ֿڳٵʱ OSTaskChangePrio Ѹȼ AnalyticsTask ȼ(ж)
+* ע    ⣺
+*          1Уmake run¼׷٣make trace
+*          2ջź֡ printfͳһʹ HOST_STK_SIZE
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+#include "os_port_posix.h"
+#include "TraceDump.h"
+#include <stdlib.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define HOST_STK_SIZE   4096  //ջС(λu32)
+#define RUN_TIME_MS     3000  //ʾʱ
+#define RR_TIME_MS      600   //ʱƬתæʱ
+#define PI_HOLD_MS      5     //PILowÿγлʱ
+#define PI_MED_START_MS 1000  //PILowڸʱʱPIMed
+#define PI_MED_BUSY_MS  300   //PIMedæʱ
+#define PEND_TIMEOUT_MS 100   //TimeoutTaskÿεȴĳʱʱ
+#define RUNINFO_MAX     24    //ͳƿյ
+#define TRACE_DRAIN_MS  20    //׷񵼳
+#define SPAWN_MS        500   //SpawnTaskʱ
+#define WORKER_PRIO     2     //ʱȼ(SpawnTask ע)
+#define CTRL_PERIOD_MS  10    //ControlTask
+#define CTRL_LATE_MS    5     //ڳٵֵʱж
+#define ANALYTICS_START 1500  //AnalyticsTaskʼʱ
+#define ANALYTICS_JOBS  10    //AnalyticsTask
+#define ANALYTICS_BUSY  20    //AnalyticsTaskÿμæʱ
+#define ANALYTICS_PRIO_LOW 11 //жAnalyticsTaskȼ
+#define PKT_BLK_NUM     4     //հڴ
+#define PKT_BLK_SIZE    32    //հڴС(ֽ)
+#define PKT_RING_SIZE   8     //ζг(ڿ )
+#define PKT_FILL_MS     50    //PacketTask׼հ
+#define CCM_SIZE        4096  //CCMС(ֽ)
+#define EXT_SRAM_SIZE   32768 //ⲿSRAMС(ֽ)
+#define DMA_BUF_SIZE    1024  //DMAС( OS_MEM_FAST_SIZE ȷ)
+#define CTRL_STATE_SIZE 64    //״̬С(̶CCM)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+//ջռTCB
+static u32 s_arrMonitorStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structMonitorHandle;
+static u32 s_arrIrqTaskStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structIrqTaskHandle;
+static u32 s_arrTestTaskStack3[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTestHandle3;
+static u32 s_arrTestTaskStack4[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTestHandle4;
+static u32 s_arrTestTaskStack5[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTestHandle5;
+static u32 s_arrTestTaskStack6[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTestHandle6;
+static u32 s_arrTestTaskStack7[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTestHandle7;
+static u32 s_arrRRTaskStack1[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structRRHandle1;
+static u32 s_arrRRTaskStack2[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structRRHandle2;
+static u32 s_arrPIHighStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structPIHighHandle;
+static u32 s_arrPIMedStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structPIMedHandle;
+static u32 s_arrPILowStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structPILowHandle;
+static u32 s_arrTimeoutStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTimeoutHandle;
+static u32 s_arrTraceStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structTraceHandle;
+static u32 s_arrNotifyStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structNotifyHandle;
+static u32 s_arrSpawnStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structSpawnHandle;
+static u32 s_arrWorkerStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structWorkerHandle;
+static u32 s_arrControlStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structControlHandle;
+static u32 s_arrAnalyticsStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structAnalyticsHandle;
+static u32 s_arrPacketStack[HOST_STK_SIZE];
+static OS_TASK_HANDLE s_structPacketHandle;
+
+//CasyOS
+static OS_MUTEX s_MutexTest;
+static OS_FLAG s_FlagTest;
+static OS_MUTEX s_MutexPI;
+static OS_TMR s_TmrLED1;
+static OS_TMR s_TmrLED2;
+static OS_MEM_PART s_PartPacket;
+static OS_MEM_REGION s_RegionCCM;     // DMA
+static OS_MEM_REGION s_RegionExtSRAM; // DMA
+static u32 s_arrCCM[CCM_SIZE / sizeof(u32)];           //CCM洢
+static u32 s_arrExtSRAM[EXT_SRAM_SIZE / sizeof(u32)];  //EXMCⲿSRAM洢
+static u32 s_arrPacketPool[PKT_BLK_NUM * PKT_BLK_SIZE / sizeof(u32)];	//հڴ洢
+
+//PacketTask洮ж֮ĵߵ߻ζ
+static void* volatile s_arrPktRing[PKT_RING_SIZE];
+static volatile u32 s_iPktHead;       //PacketTaskдλ
+static volatile u32 s_iPktTail;       //洮ж϶ȡλ
+
+//ͳ
+static volatile u32 s_iIrqCnt;   //洮жϴ
+static volatile u32 s_iSemCnt;   //Task3ȡź
+static volatile u32 s_iMsgCnt;   //Task4յϢ
+static volatile u32 s_iMutexCnt; //Task5/6ȡ
+static volatile u32 s_iFlagCnt;  //Task7Ѵ
+static volatile u32 s_arrRRTicks[2];  //RRTask1/2ռCPUĽ
+static volatile u32 s_iPIMaxBlock;    //PIHighȡʱ(ms)
+static volatile u32 s_iTimeoutCnt;    //TimeoutTaskȴʱ
+static volatile u32 s_iNotifyCnt;     //NotifyTaskۼյ֪ͨ
+static volatile u32 s_iSpawnCnt;      //ʱ񴴽
+static volatile u32 s_iWorkerCnt;     //ʱɴ
+static volatile u32 s_iSuspendHold;   //ڼյϢûеĴ
+static volatile u32 s_iCtrlLateMax;   //ControlTaskٵʱ(ms)
+static volatile u32 s_iShedCnt;       //жصĴ
+static volatile u32 s_iAnalyticsCnt;  //AnalyticsTaskɵļ
+static volatile u32 s_iPktCnt;        //洮ж겢黹հ
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void UartIrqHandler(void); //洮ڽж
+static void UartRxDefer(void *p_arg, u32 data);  //ڽӺ
+static void MonitorTask(void);    //
+static void LEDTmrCallback(OS_TMR *p_tmr, void *p_arg);  //LED˸ʱص
+static void IrqTask(void);        //ڴж
+static void TestTask3(void);      //ڽź
+static void TestTask4(void);      //ڽϢ
+static void TestTask5(void);      //
+static void TestTask6(void);      //
+static void TestTask7(void);      //¼־
+static void RRTask1(void);        //ʱƬת
+static void RRTask2(void);        //ʱƬת
+static void PIHighTask(void);     //ȼ̳в()
+static void PIMedTask(void);      //ȼ̳в()
+static void PILowTask(void);      //ȼ̳в()
+static void TimeoutTask(void);    //ʱȴ
+static void TraceTask(void);      //¼׷ٵ
+static void NotifyTask(void);     //֪ͨ
+static void SpawnTask(void);      //贴ʱ
+static void WorkerTask(void);     //ʱ(꼴)
+static void ControlTask(void);    //ڿ
+static void AnalyticsTask(void);  //̨(ɱ)
+static void PacketTask(void);     //ڴȡհ
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+typedef struct StructTaskInfo
+{
+	OS_TASK_HANDLE* handle;		//
+	void*						func;			//
+	char*						name;			//
+	u32							prio;			//ȼ
+	u32*						stkBase;	//ջ׵ַ
+	u32							stkSize;	//ջС
+	u32 						semSize;	//ڽźС
+	u32							queSize;	//ϢջС
+}StructTaskInfo;	//ͳһע
+
+static StructTaskInfo s_arrTaskInfo[] =
+{
+	{&s_structMonitorHandle, MonitorTask, "MonitorTask", 0, s_arrMonitorStack,   HOST_STK_SIZE, 0, 0},
+	{&s_structIrqTaskHandle, IrqTask,     "IrqTask",     3, s_arrIrqTaskStack,   HOST_STK_SIZE, 0, 0},
+	{&s_structTestHandle3,   TestTask3,   "TestTask3",   5, s_arrTestTaskStack3, HOST_STK_SIZE, 5, 0},
+	{&s_structTestHandle4,   TestTask4,   "TestTask4",   5, s_arrTestTaskStack4, HOST_STK_SIZE, 0, 16},
+	{&s_structTestHandle5,   TestTask5,   "TestTask5",   6, s_arrTestTaskStack5, HOST_STK_SIZE, 0, 0},
+	{&s_structTestHandle6,   TestTask6,   "TestTask6",   6, s_arrTestTaskStack6, HOST_STK_SIZE, 0, 0},
+	{&s_structTestHandle7,   TestTask7,   "TestTask7",   7, s_arrTestTaskStack7, HOST_STK_SIZE, 0, 0},
+	{&s_structRRHandle1,     RRTask1,     "RRTask1",     8, s_arrRRTaskStack1,   HOST_STK_SIZE, 0, 0},
+	{&s_structRRHandle2,     RRTask2,     "RRTask2",     8, s_arrRRTaskStack2,   HOST_STK_SIZE, 0, 0},
+	{&s_structPIHighHandle,  PIHighTask,  "PIHighTask",  4, s_arrPIHighStack,    HOST_STK_SIZE, 0, 0},
+	{&s_structPIMedHandle,   PIMedTask,   "PIMedTask",   9, s_arrPIMedStack,     HOST_STK_SIZE, 1, 0},
+	{&s_structPILowHandle,   PILowTask,   "PILowTask",  10, s_arrPILowStack,     HOST_STK_SIZE, 0, 0},
+	{&s_structTimeoutHandle, TimeoutTask, "TimeoutTask",11, s_arrTimeoutStack,   HOST_STK_SIZE, 1, 4},
+	{&s_structTraceHandle,   TraceTask,   "TraceTask",  12, s_arrTraceStack,     HOST_STK_SIZE, 0, 0},
+	{&s_structNotifyHandle,  NotifyTask,  "NotifyTask",  2, s_arrNotifyStack,    HOST_STK_SIZE, 0, 0},
+	{&s_structSpawnHandle,   SpawnTask,   "SpawnTask",   7, s_arrSpawnStack,     HOST_STK_SIZE, 0, 0},
+	{&s_structControlHandle, ControlTask, "ControlTask", 6, s_arrControlStack,   HOST_STK_SIZE, 0, 0},
+	{&s_structAnalyticsHandle, AnalyticsTask, "Analytics", 5, s_arrAnalyticsStack, HOST_STK_SIZE, 0, 0},
+	{&s_structPacketHandle,  PacketTask,  "PacketTask",  3, s_arrPacketStack,    HOST_STK_SIZE, 0, 0},
+};
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣUartIrqHandler
+* ܣ洮ڽж ǼӺ֪ͨ NotifyTask õһհ黹ڴ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺Ŀ USART0_IRQHandler дһ£ǰ OSIntEnter/OSIntExit
+*********************************************************************************************************/
+static void UartIrqHandler(void)
+{
+	u8 *p_pkt;
+
+	OSIntEnter();
+	s_iIrqCnt++;
+	if(s_iPktTail != s_iPktHead)
+	{
+		p_pkt = (u8*)s_arrPktRing[s_iPktTail % PKT_RING_SIZE];
+		s_iPktTail++;
+		p_pkt[0] = (u8)s_iIrqCnt;			//ģ
+		OSMemPartPut(&s_PartPacket, p_pkt);	//ڵȴʱֱӽ
+		s_iPktCnt++;
+	}
+	OSDeferPost(UartRxDefer, NULL, s_iIrqCnt);
+	OSTaskNotify(&s_structNotifyHandle, 0, OS_NOTIFY_INCREMENT);
+	OSIntExit();
+}
+
+/*********************************************************************************************************
+* ƣUartRxDefer
+* ܣڽӺ  Task3 ͷź Task4 Ϣλ־
+* p_arg: δʹ data: ж
+* void
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺Ӻִ
+*********************************************************************************************************/
+static void UartRxDefer(void *p_arg, u32 data)
+{
+	OSSemPost(&s_structTestHandle3.sem);
+	OSQPost(&s_structTestHandle4, data);
+	OSFlagPost(&s_FlagTest, (1 << 0) | (1 << 1), OS_FLAG_SET);
+}
+
+/*********************************************************************************************************
+* ƣMonitorTask
+* ܣ RUN_TIME_MS ӡͳϢ˳
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*********************************************************************************************************/
+static void MonitorTask(void)
+{
+	static OS_TASK_RUNINFO s_arrRunInfo[RUNINFO_MAX];
+	OS_DEFER_STATS defer;
+	OS_MEM_PART_STATS part;
+	OS_MEM_STATS heap;
+	u32 used;
+	u32 sram;
+	u32 ccm;
+	u32 ext;
+	u32 wakeups;
+	u32 num;
+	u32 i;
+	u16 load;
+
+	OSDelay(RUN_TIME_MS);
+
+	used = OSMemoryPerused();
+	wakeups = OSGetWakeupCnt();
+	printf("[Monitor] Irq = %u, Sem = %u, Msg = %u, Mutex = %u, Flag = %u\r\n",
+	       s_iIrqCnt, s_iSemCnt, s_iMsgCnt, s_iMutexCnt, s_iFlagCnt);
+	printf("[Monitor] Memory Used = %u.%u%%, Heap Check = %s\r\n", used / 10, used % 10, OSMemCheck() ? "OK" : "FAIL");
+	sram = OSMemRegionPerused(NULL);
+	ccm  = OSMemRegionPerused(&s_RegionCCM);
+	ext  = OSMemRegionPerused(&s_RegionExtSRAM);
+	printf("[Monitor] Region SRAM = %u.%u%%, CCM = %u.%u%%, ExtSRAM = %u.%u%%\r\n",
+	       sram / 10, sram % 10, ccm / 10, ccm % 10, ext / 10, ext % 10);
+	OSMemStats(&heap);
+	printf("[Monitor] Heap Free = %u/%u, Min = %u, Largest = %u, Frags = %u, Alloc = %u, Free = %u, Fail = %u\r\n",
+	       heap.freeBytes, heap.totalBytes, heap.freeMin, heap.largestFree, heap.fragNum,
+	       heap.allocCnt, heap.freeCnt, heap.failCnt);
+	printf("[Monitor] RR Ticks: RRTask1 = %u, RRTask2 = %u\r\n", s_arrRRTicks[0], s_arrRRTicks[1]);
+	printf("[Monitor] PI Max Block = %u ms (Inherit = %d)\r\n", s_iPIMaxBlock, OS_CFG_MUTEX_PI_EN);
+	printf("[Monitor] Pend Timeouts = %u\r\n", s_iTimeoutCnt);
+	printf("[Monitor] Notify = %u\r\n", s_iNotifyCnt);
+	printf("[Monitor] Worker Spawn = %u, Done = %u, Suspend Hold = %u\r\n", s_iSpawnCnt, s_iWorkerCnt, s_iSuspendHold);
+	printf("[Monitor] Control Late Max = %u ms, Shed = %u, Analytics Jobs = %u/%u\r\n",
+	       s_iCtrlLateMax, s_iShedCnt, s_iAnalyticsCnt, ANALYTICS_JOBS);
+	OSMemPartStatsGet(&s_PartPacket, &part);
+	printf("[Monitor] Packet Part Get = %u, Put = %u, Free = %u/%u, Used Max = %u, Fail = %u\r\n",
+	       part.getCnt, s_iPktCnt, part.freeNum, part.blockNum, part.usedMax, part.failCnt);
+	OSDeferStatsGet(&defer);
+	printf("[Monitor] Defer Run = %u/%u, Overflow = %u, Depth Max = %u, Latency Avg = %u us, Max = %u us\r\n",
+	       defer.runCnt, defer.postCnt, defer.overflowCnt, defer.depthMax, defer.latencyAvgUs, defer.latencyMaxUs);
+	printf("[Monitor] Tick = %llu, Wakeups = %u (%u/s, Tickless = %d)\r\n",
+	       (unsigned long long)OSTimeGet(), wakeups, wakeups * 1000 / RUN_TIME_MS, OS_CFG_TICKLESS_EN);
+
+	num = OSTaskRunInfoGet(s_arrRunInfo, RUNINFO_MAX, &load);
+	printf("[Monitor] CPU Load = %u.%u%%\r\n", load / 10, load % 10);
+	printf("[Monitor] %-12s %4s %10s %8s %6s\r\n", "Task", "Prio", "Run(us)", "Switch", "CPU");
+	for(i = 0; i < num; i++)
+	{
+		printf("[Monitor] %-12s %4u %10llu %8u %4u.%u%%\r\n", s_arrRunInfo[i].name, s_arrRunInfo[i].priority,
+		       (unsigned long long)s_arrRunInfo[i].runTimeUs, s_arrRunInfo[i].switchCnt,
+		       s_arrRunInfo[i].usage / 10, s_arrRunInfo[i].usage % 10);
+	}
+	OSTaskStackReport();
+	TraceDumpClose();
+	fflush(stdout);
+	exit(0);
+}
+
+/*********************************************************************************************************
+* ƣLEDTmrCallback
+* ܣģLED˸
+* p_tmr: ڵĶʱ p_arg: LED״ַ̬
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ڶʱִУûĽӿ
+*********************************************************************************************************/
+static void LEDTmrCallback(OS_TMR *p_tmr, void *p_arg)
+{
+	u8 *p_led = (u8*)p_arg;
+
+	*p_led = 1 - *p_led;
+	printf("[%s] %s\r\n", (char*)p_tmr->name, *p_led ? "ON" : "OFF");
+}
+
+/*********************************************************************************************************
+* ƣIrqTask
+* ܣÿ 200ms һη洮ж
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*********************************************************************************************************/
+static void IrqTask(void)
+{
+	while(1)
+	{
+		OSDelay(200);
+		OS_PortRaiseIrq();
+	}
+}
+
+/*********************************************************************************************************
+* ƣTestTask3
+* ܣź
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*********************************************************************************************************/
+static void TestTask3(void)
+{
+	while(1)
+	{
+		OSSemPend(&s_structTestHandle3.sem);
+		s_iSemCnt++;
+		printf("[Task3] Get Sem, Count = %u\r\n", s_structTestHandle3.sem.count);
+	}
+}
+
+/*********************************************************************************************************
+* ƣTestTask4
+* ܣڽϢ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺ָΪ64λϢֱӴ
+*********************************************************************************************************/
+static void TestTask4(void)
+{
+	u32 data;
+
+	while(1)
+	{
+		OSQPend(&data);
+		s_iMsgCnt++;
+		printf("[Task4] Get Message: %u\r\n", data);
+	}
+}
+
+/*********************************************************************************************************
+* ƣTestTask5 TestTask6
+* ܣԻ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺Task5ݹռڳڼʱ ӡϢ޴ ˵
+*********************************************************************************************************/
+static void TestTask5(void)
+{
+	while(1)
+	{
+		OSMutexPend(&s_MutexTest);
+		OSMutexPend(&s_MutexTest);	//Task5ݹȡ2
+		s_iMutexCnt++;
+		printf("[Task5] Lock ");
+		OSDelay(50);
+		OSMutexPost(&s_MutexTest);	//һν(ȫͷ)
+		OSDelay(50);
+		printf("Unlock\r\n");
+		OSMutexPost(&s_MutexTest);	//ڶν(ȫͷ)
+		OSDelay(100);
+	}
+}
+
+static void TestTask6(void)
+{
+	while(1)
+	{
+		OSMutexPend(&s_MutexTest);
+		s_iMutexCnt++;
+		printf("[Task6] Got Mutex\r\n");
+		OSMutexPost(&s_MutexTest);
+		OSDelay(100);
+	}
+}
+
+/*********************************************************************************************************
+* ƣTestTask7
+* ܣ¼־
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺ȴ A&B λ־λ
+*********************************************************************************************************/
+static void TestTask7(void)
+{
+	while(1)
+	{
+		OSFlagPend(&s_FlagTest, (1 << 0) | (1 << 1), OS_FLAG_WAIT_SET_ALL);
+		s_iFlagCnt++;
+		printf("[Task7] Wakeup! (A&B matched, flags consumed)\r\n");
+	}
+}
+
+/*********************************************************************************************************
+* ƣRRTaskBusy
+* ܣæ RR_TIME_MSͳƱڼ侭Ľ
+* idx: ͳ±
+* void
+*   ֵvoid
+* ڣ20260206
+* ע    ⣺ѭвκӿڣֻʱƬתóCPU
+*********************************************************************************************************/
+static void RRTaskBusy(u32 idx)
+{
+	u64 last;
+	u64 now;
+
+	last = OSTimeGet();
+	while(last < RR_TIME_MS)
+	{
+		now = OSTimeGet();
+		if(now != last)
+		{
+			s_arrRRTicks[idx]++;
+			last = now;
+		}
+	}
+
+	while(1)
+	{
+		OSDelay(RUN_TIME_MS);
+	}
+}
+
+static void RRTask1(void)
+{
+	RRTaskBusy(0);
+}
+
+static void RRTask2(void)
+{
+	RRTaskBusy(1);
+}
+
+/*********************************************************************************************************
+* ƣBusyWait
+* ܣæָ(óCPU)
+* ms: æʱ
+* void
+*   ֵvoid
+* ڣ20260207
+* ע    ⣺
+*********************************************************************************************************/
+static void BusyWait(u32 ms)
+{
+	u64 end;
+
+	end = OSTimeGet() + ms;
+	while(OSTimeGet() < end)
+	{
+	}
+}
+
+/*********************************************************************************************************
+* ƣPIHighTask / PIMedTask / PILowTask
+* ܣȼת
+* void
+* void
+*   ֵvoid
+* ڣ20260207
+* ע    ⣺
+*           (1) PILow Գ s_MutexPI Լ PI_HOLD_MS
+*           (2) PIMed ȼ֮䣬PI_MED_START_MS ɳе PILow ѣæ PI_MED_BUSY_MS
+*           (3) ȼ̳ʱ PIHigh ӽ PI_MED_BUSY_MSм̳ʱ PI_HOLD_MS
+*********************************************************************************************************/
+static void PIHighTask(void)
+{
+	u64 start;
+	u32 block;
+
+	while(1)
+	{
+		OSDelay(7);
+		start = OSTimeGet();
+		OSMutexPend(&s_MutexPI);
+		block = (u32)(OSTimeGet() - start);
+		if(block > s_iPIMaxBlock)
+		{
+			s_iPIMaxBlock = block;
+		}
+		OSMutexPost(&s_MutexPI);
+	}
+}
+
+static void PIMedTask(void)
+{
+	OSSemPend(&s_structPIMedHandle.sem);
+	BusyWait(PI_MED_BUSY_MS);
+	while(1)
+	{
+		OSDelay(RUN_TIME_MS);
+	}
+}
+
+static void PILowTask(void)
+{
+	u8 medWoken = 0;
+
+	while(1)
+	{
+		OSMutexPend(&s_MutexPI);
+		if(OSTimeGet() >= PI_MED_START_MS && medWoken == 0)
+		{
+			medWoken = 1;
+			OSSemPost(&s_structPIMedHandle.sem);	//ڼ份PIMed ֻһ
+		}
+		BusyWait(PI_HOLD_MS);
+		OSMutexPost(&s_MutexPI);
+		OSDelay(3);
+	}
+}
+
+/*********************************************************************************************************
+* ƣTimeoutTask
+* ܣͷŵźϢС¼־ϴʱȴ ͳƳʱ
+* void
+* void
+*   ֵvoid
+* ڣ20260208
+* ע    ⣺ÿεȴӦ PEND_TIMEOUT_MS  OS_PEND_TIMEOUT 
+*********************************************************************************************************/
+static void TimeoutTask(void)
+{
+	u32 msg;
+	u64 start;
+	u32 wait;
+
+	while(1)
+	{
+		start = OSTimeGet();
+		if(OSSemPendTimeout(&s_structTimeoutHandle.sem, PEND_TIMEOUT_MS) == OS_PEND_TIMEOUT)
+		{
+			s_iTimeoutCnt++;
+		}
+		if(OSQPendTimeout(&msg, PEND_TIMEOUT_MS) == OS_PEND_TIMEOUT)
+		{
+			s_iTimeoutCnt++;
+		}
+		if(OSFlagPendTimeout(&s_FlagTest, (1 << 2), OS_FLAG_WAIT_SET_ALL, PEND_TIMEOUT_MS) == OS_PEND_TIMEOUT)
+		{
+			s_iTimeoutCnt++;
+		}
+		wait = (u32)(OSTimeGet() - start);
+		printf("[Timeout] 3 x %u ms waits took %u ms\r\n", PEND_TIMEOUT_MS, wait);
+	}
+}
+
+/*********************************************************************************************************
+* ƣTraceTask
+* ܣȡں¼׷ټ¼дļ
+* void
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺ȼв ¼Ҳ׷ټ¼
+*********************************************************************************************************/
+static void TraceTask(void)
+{
+	while(1)
+	{
+		TraceDumpDrain();
+		OSDelay(TRACE_DRAIN_MS);
+	}
+}
+
+/*********************************************************************************************************
+* ƣNotifyTask
+* ܣȴ洮жϷ֪ͨ ۼ֪ͨ
+* void
+* void
+*   ֵvoid
+* ڣ20260216
+* ע    ⣺źʹ ȡߺ һλѿܴض֪ͨ
+*********************************************************************************************************/
+static void NotifyTask(void)
+{
+	u32 value;
+
+	while(1)
+	{
+		if(OSTaskNotifyWait(0, 0xFFFFFFFF, &value, OS_WAIT_FOREVER) == OS_PEND_OK)
+		{
+			s_iNotifyCnt += value;
+			printf("[Notify] Get Notify x %u\r\n", value);
+		}
+	}
+}
+
+/*********************************************************************************************************
+* ƣSpawnTask
+* ܣÿ SPAWN_MS һʱ ʾڼȴ
+* void
+* void
+*   ֵvoid
+* ڣ20260217
+* ע    ⣺
+*           (1) ȼ עвȴϢ
+*           (2) ȹٷϢյϢֹ ָ  return ɾ
+*           (3) һɾŸ TCB ջ Ϣлÿɾʱͷ
+*********************************************************************************************************/
+static void SpawnTask(void)
+{
+	while(1)
+	{
+		OSDelay(SPAWN_MS);
+		if(s_iWorkerCnt != s_iSpawnCnt)	//һûн
+		{
+			continue;
+		}
+
+		s_iSpawnCnt++;
+		OSRegister(&s_structWorkerHandle, WorkerTask, "WorkerTask", WORKER_PRIO, s_arrWorkerStack, HOST_STK_SIZE, 0, 4);
+
+		OSTaskSuspend(&s_structWorkerHandle);
+		OSQPost(&s_structWorkerHandle, s_iSpawnCnt);
+		if(s_structWorkerHandle.state == OS_TASK_STOP && s_iWorkerCnt != s_iSpawnCnt)
+		{
+			s_iSuspendHold++;
+		}
+		OSTaskResume(&s_structWorkerHandle);
+	}
+}
+
+/*********************************************************************************************************
+* ƣWorkerTask
+* ܣʱ һϢ󷵻
+* void
+* void
+*   ֵvoid
+* ڣ20260217
+* ע    ⣺غں˳ OS_TaskReturn ɾ
+*********************************************************************************************************/
+static void WorkerTask(void)
+{
+	u32 job;
+
+	if(OSQPendTimeout(&job, SPAWN_MS) == OS_PEND_OK)
+	{
+		s_iWorkerCnt++;
+		printf("[Worker] Job %u Done\r\n", job);
+	}
+}
+
+/*********************************************************************************************************
+* ƣControlTask
+* ܣÿ CTRL_PERIOD_MS ִһο ٵ CTRL_LATE_MS ʱ AnalyticsTask ȼ
+* void
+* void
+*   ֵvoid
+* ڣ20260218
+* ע    ⣺
+*           (1) ʱų ٵ = ʵʱ - ƻʱ ٵӵǰʱų
+*           (2) ֻжһ AnalyticsTask ڿе CPU ϼʣ
+*********************************************************************************************************/
+static void ControlTask(void)
+{
+	u64 next;
+	u64 now;
+	u32 late;
+
+	next = OSTimeGet() + CTRL_PERIOD_MS;
+	while(1)
+	{
+		now = OSTimeGet();
+		if(now < next)
+		{
+			OSDelay((u32)(next - now));
+			now = OSTimeGet();
+		}
+
+		late = (u32)(now - next);
+		if(late > s_iCtrlLateMax)
+		{
+			s_iCtrlLateMax = late;
+		}
+		if(late > CTRL_LATE_MS && s_structAnalyticsHandle.basePriority != ANALYTICS_PRIO_LOW)
+		{
+			OSTaskChangePrio(&s_structAnalyticsHandle, ANALYTICS_PRIO_LOW);
+			s_iShedCnt++;
+			printf("[Control] %u ms late, Analytics -> Prio %u\r\n", late, ANALYTICS_PRIO_LOW);
+		}
+		next = now + CTRL_PERIOD_MS;
+	}
+}
+
+/*********************************************************************************************************
+* ƣAnalyticsTask
+* ܣANALYTICS_START ִ ANALYTICS_JOBS κʱ ɺ󷵻
+* void
+* void
+*   ֵvoid
+* ڣ20260218
+* ע    ⣺ʼȼ ControlTask ÿμֻ֮ó1 ǰ ControlTask سٵ
+*********************************************************************************************************/
+static void AnalyticsTask(void)
+{
+	u32 i;
+
+	OSDelay(ANALYTICS_START);
+	for(i = 0; i < ANALYTICS_JOBS; i++)
+	{
+		BusyWait(ANALYTICS_BUSY);
+		s_iAnalyticsCnt++;
+		OSDelay(1);
+	}
+}
+
+/*********************************************************************************************************
+* ƣPacketTask
+* ܣÿ PKT_FILL_MS հڴȡһ黺洮ж
+* void
+* void
+*   ֵvoid
+* ڣ20260220
+* ע    ⣺
+*           (1) ȡжõÿ PKT_BLK_NUM ڷ
+*           (2) ֮ÿжϹ黹һ鶼ֱӽ ȡԼΪ PKT_BLK_NUM + жϴ
+*********************************************************************************************************/
+static void PacketTask(void)
+{
+	void *p_pkt;
+
+	while(1)
+	{
+		p_pkt = OSMemPartGetTimeout(&s_PartPacket, OS_WAIT_FOREVER);
+		if(p_pkt != NULL)
+		{
+			s_arrPktRing[s_iPktHead % PKT_RING_SIZE] = p_pkt;
+			s_iPktHead++;
+		}
+		OSDelay(PKT_FILL_MS);
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣmain
+* ܣ
+* argv[1]: ¼׷ļ·(ѡ)
+* void
+*   ֵint
+* ڣ20260202
+* ע    ⣺
+*********************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	u32 i;
+	u32 err;
+	static u8 s_iLED1 = 0;
+	static u8 s_iLED2 = 0;
+
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	InitCasyOS();			//ʼCasyOS
+	printf("Init System has been finished\r\n");
+
+	OSMutexCreate(&s_MutexTest, (u8*)"TestMutex");	//
+	OSFlagCreate(&s_FlagTest, (u8*)"TestFlag", 0);	//¼־
+	OSMutexCreate(&s_MutexPI, (u8*)"PIMutex");			//ȼ̳вԻ
+	OSMemPartCreate(&s_PartPacket, (u8*)"PacketPart", s_arrPacketPool, PKT_BLK_NUM, PKT_BLK_SIZE);	//հڴ
+
+	//עCCMⲿSRAM ״̶̬CCM DMAֻܷڿDMA(˴ⲿSRAM)
+	OSMemRegionAdd(&s_RegionCCM, (u8*)"CCM", s_arrCCM, CCM_SIZE, OS_MEM_ATTR_FAST);
+	OSMemRegionAdd(&s_RegionExtSRAM, (u8*)"ExtSRAM", s_arrExtSRAM, EXT_SRAM_SIZE, OS_MEM_ATTR_DMA);
+	OSMallocFrom(&s_RegionCCM, CTRL_STATE_SIZE);
+	OSMallocAttr(DMA_BUF_SIZE, OS_MEM_ATTR_DMA);
+	OS_PortSetIrqHandler(UartIrqHandler);						//ע洮ж
+
+	//LED˸ʱ ״ε(1 tick) ֮ڷת
+	OSTmrCreate(&s_TmrLED1, (u8*)"LED1", 1, 300, OS_TMR_OPT_PERIODIC, LEDTmrCallback, &s_iLED1);
+	OSTmrCreate(&s_TmrLED2, (u8*)"LED2", 1, 700, OS_TMR_OPT_PERIODIC, LEDTmrCallback, &s_iLED2);
+	OSTmrStart(&s_TmrLED1);
+	OSTmrStart(&s_TmrLED2);
+
+	//
+	for(i = 0; i < sizeof(s_arrTaskInfo) / sizeof(StructTaskInfo); i++)
+	{
+		err = OSRegister(s_arrTaskInfo[i].handle,
+		                 s_arrTaskInfo[i].func,
+		                 s_arrTaskInfo[i].name,
+		                 s_arrTaskInfo[i].prio,
+		                 s_arrTaskInfo[i].stkBase,
+		                 s_arrTaskInfo[i].stkSize,
+		                 s_arrTaskInfo[i].semSize,
+		                 s_arrTaskInfo[i].queSize);
+		if(err != 0)
+		{
+			printf("Fail to create %s (%u)\r\n", s_arrTaskInfo[i].name, err);
+			return 1;
+		}
+	}
+
+	OSTaskSetTimeQuanta(&s_structRRHandle2, OS_CFG_TIME_QUANTA_DEFAULT / 2);	//RRTask2ʹһʱƬ
+
+	if(argc > 1 && TraceDumpOpen(argv[1]))
+	{
+		printf("Trace will be written to %s\r\n", argv[1]);
+	}
+
+	//CasyOS
+	OSStart();
+	return 0;
+}
@@ -0,0 +1,386 @@
+/*********************************************************************************************************
+* ģƣTraceDecode.c
+* ժ    Ҫں¼׷ļ빤ߣˣ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260213
+*     ݣ
+*           (1) ȡ TraceDump ļչ 32 λʱƣл¼ԭÿ
+*           (2) Ĭͳƣʱ䡢ƬƬΡ/ʱPost/Pend 
+*           (3) -e ʱ˳гȫ¼-t  гԼص¼
+*           (4) ÷trace_decode [-e] [-t ] ׷ļ
+* ע    ⣺
+*           (1) жִʱ뱻ϵⵥͳжʱ
+*           (2) һл¼֮ǰʱ޷ͳ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "TraceDump.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define DECODE_ID_MAX  256  //Ÿ(u8)
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+typedef struct StructTaskStat
+{
+	char name[OS_TRACE_NAME_LEN];  //
+	u32  prio;                     //ȼ
+	u8   valid;                    //Ƿ
+	u64  runTime;                  //ۼʱ(ʱ)
+	u64  maxSlice;                 //һ
+	u32  slices;                   //лĴ
+	u32  ready;                    //ȴ
+	u32  timeout;                  //ȴʱ
+	u32  post;                     //Post (̬)
+	u32  pend;                     //Pend 
+	u32  block;                    //Pend ҪĴ
+}StructTaskStat;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static TRACE_FILE_HDR s_structHdr;
+static StructTaskStat s_arrTask[DECODE_ID_MAX];
+static const char*    s_arrEventName[OS_TRACE_EVENT_NUM] =
+{
+	"NONE", "SWITCH", "READY", "ISR_ENTER", "ISR_EXIT",
+	"SEM_POST", "SEM_PEND", "Q_POST", "Q_PEND",
+	"MUTEX_POST", "MUTEX_PEND", "FLAG_POST", "FLAG_PEND",
+	"NOTIFY_POST", "NOTIFY_PEND", "MEM_PUT", "MEM_GET"
+};
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static const char* TaskName(u32 id);                     //ת
+static double      TsToUs(u64 ts);                       //ʱת΢
+static void        PrintEvent(u64 ts, OS_TRACE_REC *p_rec, u32 nest);  //ӡһ¼
+static u8          IsPost(u8 event);                     //ǷΪ Post ¼
+static u8          IsPend(u8 event);                     //ǷΪ Pend ¼
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣTaskName
+* ܣת
+* id: 
+* void
+*   ֵ δ֪ŷ "?"
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+static const char* TaskName(u32 id)
+{
+	if(id == OS_TRACE_ID_NONE)
+	{
+		return "-";
+	}
+	return s_arrTask[id & 0xFF].valid ? s_arrTask[id & 0xFF].name : "?";
+}
+
+/*********************************************************************************************************
+* ƣTsToUs
+* ܣʱת΢
+* ts: Եһ¼ʱ
+* void
+*   ֵ΢
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+static double TsToUs(u64 ts)
+{
+	return (double)ts * 1000000.0 / (double)s_structHdr.freq;
+}
+
+/*********************************************************************************************************
+* ƣIsPost
+* ܣжǷΪ Post ¼
+* event: ¼
+* void
+*   ֵ1- 0-
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+static u8 IsPost(u8 event)
+{
+	return event == OS_TRACE_SEM_POST || event == OS_TRACE_Q_POST ||
+	       event == OS_TRACE_MUTEX_POST || event == OS_TRACE_FLAG_POST ||
+	       event == OS_TRACE_NOTIFY_POST || event == OS_TRACE_MEM_PUT;
+}
+
+/*********************************************************************************************************
+* ƣIsPend
+* ܣжǷΪ Pend ¼
+* event: ¼
+* void
+*   ֵ1- 0-
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+static u8 IsPend(u8 event)
+{
+	return event == OS_TRACE_SEM_PEND || event == OS_TRACE_Q_PEND ||
+	       event == OS_TRACE_MUTEX_PEND || event == OS_TRACE_FLAG_PEND ||
+	       event == OS_TRACE_NOTIFY_PEND || event == OS_TRACE_MEM_GET;
+}
+
+/*********************************************************************************************************
+* ƣPrintEvent
+* ܣӡһ¼
+* ts: ʱ p_rec: ¼ nest: ¼жǶײ
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺жз Post  [ISR]
+*********************************************************************************************************/
+static void PrintEvent(u64 ts, OS_TRACE_REC *p_rec, u32 nest)
+{
+	const char *p_evt;
+	u8 inIsr;
+
+	p_evt = (p_rec->event < OS_TRACE_EVENT_NUM) ? s_arrEventName[p_rec->event] : "UNKNOWN";
+	inIsr = (nest > 0 && p_rec->event != OS_TRACE_ISR_ENTER) || p_rec->event == OS_TRACE_ISR_EXIT;
+
+	printf("%12.1f us  %-12s%-6s %-10s ", TsToUs(ts), TaskName(p_rec->taskId), inIsr ? "[ISR]" : "", p_evt);
+	switch(p_rec->event)
+	{
+		case OS_TRACE_TASK_SWITCH:
+			printf("%s -> %s\r\n", TaskName(p_rec->arg), TaskName(p_rec->taskId));
+			break;
+		case OS_TRACE_TASK_READY:
+			printf("obj=0x%08x wake %s%s\r\n", p_rec->obj, TaskName(p_rec->arg & 0xFF),
+			       (p_rec->arg >> 8) == OS_PEND_TIMEOUT ? " (timeout)" : "");
+			break;
+		case OS_TRACE_ISR_ENTER:
+		case OS_TRACE_ISR_EXIT:
+			printf("nest=%u\r\n", p_rec->arg);
+			break;
+		default:
+			if(IsPend(p_rec->event))
+			{
+				printf("obj=0x%08x %s\r\n", p_rec->obj, p_rec->arg ? "block" : "ok");
+			}
+			else
+			{
+				printf("obj=0x%08x arg=%u\r\n", p_rec->obj, p_rec->arg);
+			}
+			break;
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣmain
+* ܣ׷ļ
+* argc/argv: [-e] [-t ] ׷ļ
+* void
+*   ֵ0-ɹ 1-ʧ
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	FILE *p_file;
+	const char *p_path = NULL;
+	const char *p_focus = NULL;
+	OS_TRACE_TASK task;
+	OS_TRACE_REC rec;
+	u8  listAll = 0;
+	u32 focusId = DECODE_ID_MAX;
+	u32 i;
+	u32 recNum = 0;
+	u32 lastTs = 0;
+	u64 now = 0;
+	u64 sliceStart = 0;
+	u64 isrStart = 0;
+	u64 isrTime = 0;
+	u64 slice;
+	u32 cur = DECODE_ID_MAX;
+	u32 nest = 0;
+	u32 isrNum = 0;
+	u32 id;
+
+	for(i = 1; i < (u32)argc; i++)
+	{
+		if(strcmp(argv[i], "-e") == 0)
+		{
+			listAll = 1;
+		}
+		else if(strcmp(argv[i], "-t") == 0 && i + 1 < (u32)argc)
+		{
+			p_focus = argv[++i];
+		}
+		else
+		{
+			p_path = argv[i];
+		}
+	}
+	if(p_path == NULL)
+	{
+		printf("Usage: %s [-e] [-t task] trace.bin\r\n", argv[0]);
+		return 1;
+	}
+
+	p_file = fopen(p_path, "rb");
+	if(p_file == NULL)
+	{
+		printf("ERROR:[TraceDecode] Can not open %s!\r\n", p_path);
+		return 1;
+	}
+	if(fread(&s_structHdr, sizeof(s_structHdr), 1, p_file) != 1 || s_structHdr.magic != TRACE_FILE_MAGIC ||
+	   s_structHdr.version != TRACE_FILE_VERSION || s_structHdr.freq == 0)
+	{
+		printf("ERROR:[TraceDecode] %s is not a CasyOS trace file!\r\n", p_path);
+		fclose(p_file);
+		return 1;
+	}
+
+	//
+	for(i = 0; i < s_structHdr.taskNum; i++)
+	{
+		if(fread(&task, sizeof(task), 1, p_file) != 1)
+		{
+			printf("ERROR:[TraceDecode] Truncated task table!\r\n");
+			fclose(p_file);
+			return 1;
+		}
+		task.name[OS_TRACE_NAME_LEN - 1] = '\0';
+		memcpy(s_arrTask[task.taskId].name, task.name, OS_TRACE_NAME_LEN);
+		s_arrTask[task.taskId].prio  = task.priority;
+		s_arrTask[task.taskId].valid = 1;
+		if(p_focus != NULL && strcmp(task.name, p_focus) == 0)
+		{
+			focusId = task.taskId;
+		}
+	}
+	if(p_focus != NULL && focusId == DECODE_ID_MAX)
+	{
+		printf("ERROR:[TraceDecode] No task named %s!\r\n", p_focus);
+		fclose(p_file);
+		return 1;
+	}
+
+	//طż¼
+	while(fread(&rec, sizeof(rec), 1, p_file) == 1)
+	{
+		//չ32λʱ ǶжϿʹڼ¼΢ зŲֵ
+		if(recNum > 0)
+		{
+			now += (u64)(long long)(i32)(rec.timestamp - lastTs);
+		}
+		lastTs = rec.timestamp;
+		recNum++;
+
+		switch(rec.event)
+		{
+			case OS_TRACE_TASK_SWITCH:
+				if(cur < DECODE_ID_MAX)
+				{
+					slice = now - sliceStart;
+					s_arrTask[cur].runTime += slice;
+					if(slice > s_arrTask[cur].maxSlice)
+					{
+						s_arrTask[cur].maxSlice = slice;
+					}
+					if(cur == focusId)
+					{
+						printf("%12.1f us  %-12s%-6s %-10s ran %.1f us since %.1f us\r\n", TsToUs(now), TaskName(cur), "", "OUT",
+						       TsToUs(slice), TsToUs(sliceStart));
+					}
+				}
+				cur = rec.taskId;
+				sliceStart = now;
+				s_arrTask[cur].slices++;
+				break;
+			case OS_TRACE_TASK_READY:
+				id = rec.arg & 0xFF;
+				s_arrTask[id].ready++;
+				if((rec.arg >> 8) == OS_PEND_TIMEOUT)
+				{
+					s_arrTask[id].timeout++;
+				}
+				break;
+			case OS_TRACE_ISR_ENTER:
+				if(rec.arg == 1)
+				{
+					isrStart = now;
+					isrNum++;
+				}
+				nest = rec.arg;
+				break;
+			case OS_TRACE_ISR_EXIT:
+				if(rec.arg == 0 && nest > 0)
+				{
+					isrTime += now - isrStart;
+				}
+				nest = rec.arg;
+				break;
+			default:
+				if(nest == 0 && IsPost(rec.event))
+				{
+					s_arrTask[rec.taskId].post++;
+				}
+				if(IsPend(rec.event))
+				{
+					s_arrTask[rec.taskId].pend++;
+					s_arrTask[rec.taskId].block += (rec.arg != 0);
+				}
+				break;
+		}
+
+		if(listAll || (focusId < DECODE_ID_MAX && rec.event != OS_TRACE_TASK_SWITCH &&
+		   (rec.taskId == focusId || (rec.event == OS_TRACE_TASK_READY && (rec.arg & 0xFF) == focusId))))
+		{
+			PrintEvent(now, &rec, nest);
+		}
+	}
+	fclose(p_file);
+
+	//һƬνֹһ¼
+	if(cur < DECODE_ID_MAX)
+	{
+		slice = now - sliceStart;
+		s_arrTask[cur].runTime += slice;
+		if(slice > s_arrTask[cur].maxSlice)
+		{
+			s_arrTask[cur].maxSlice = slice;
+		}
+	}
+
+	printf("[TraceDecode] Records = %u, Lost = %u, Span = %.3f ms, Timestamp = %u Hz\r\n",
+	       recNum, s_structHdr.lost, TsToUs(now) / 1000.0, s_structHdr.freq);
+	printf("[TraceDecode] Interrupts = %u, ISR Time = %.1f us\r\n", isrNum, TsToUs(isrTime));
+	printf("[TraceDecode] %-12s %4s %10s %7s %9s %6s %7s %5s %5s %5s\r\n",
+	       "Task", "Prio", "Run(us)", "Slices", "Max(us)", "Ready", "Timeout", "Post", "Pend", "Block");
+	for(i = 0; i < DECODE_ID_MAX; i++)
+	{
+		if(!s_arrTask[i].valid)
+		{
+			continue;
+		}
+		printf("[TraceDecode] %-12s %4u %10.0f %7u %9.1f %6u %7u %5u %5u %5u\r\n",
+		       s_arrTask[i].name, s_arrTask[i].prio, TsToUs(s_arrTask[i].runTime), s_arrTask[i].slices,
+		       TsToUs(s_arrTask[i].maxSlice), s_arrTask[i].ready, s_arrTask[i].timeout,
+		       s_arrTask[i].post, s_arrTask[i].pend, s_arrTask[i].block);
+	}
+
+	return 0;
+}
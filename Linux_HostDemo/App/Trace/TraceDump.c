@@ -0,0 +1,144 @@
+/*********************************************************************************************************
+* ģƣTraceDump.c
+* ժ    Ҫں¼׷ټ¼ļ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260213
+*     ݣ
+*           (1) ״εʱдļͷֻ֮׷Ӽ¼
+*           (2) ʾеĵȼ׷ڵ TraceDumpDrain˳ǰɼ TraceDumpClose
+* ע    ⣺
+*           (1) ÿֻںȡ TRACE_READ_NUM ȡʱʱж
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "TraceDump.h"
+#include <stdio.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define TRACE_READ_NUM   64  //ÿδں˶ȡļ¼
+#define TRACE_TASK_MAX   32  //
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static FILE*          s_pTraceFile;                     //׷ļ
+static u8             s_iHdrWritten;                    //ļͷǷд
+static TRACE_FILE_HDR s_structHdr;                      //ļͷ
+static OS_TRACE_REC   s_arrRecBuf[TRACE_READ_NUM];      //ȡ
+static OS_TRACE_TASK  s_arrTaskTab[TRACE_TASK_MAX];     //
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void TraceDumpWriteHdr(void);  //дļͷ
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣTraceDumpWriteHdr
+* ܣдļͷ
+* void
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺ŵ ʱע
+*********************************************************************************************************/
+static void TraceDumpWriteHdr(void)
+{
+	s_structHdr.magic   = TRACE_FILE_MAGIC;
+	s_structHdr.version = TRACE_FILE_VERSION;
+	s_structHdr.freq    = OS_PortTimestampFreq();
+	s_structHdr.taskNum = OSTraceTaskTableGet(s_arrTaskTab, TRACE_TASK_MAX);
+	s_structHdr.lost    = 0;
+
+	fwrite(&s_structHdr, sizeof(s_structHdr), 1, s_pTraceFile);
+	fwrite(s_arrTaskTab, sizeof(OS_TRACE_TASK), s_structHdr.taskNum, s_pTraceFile);
+	s_iHdrWritten = 1;
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣTraceDumpOpen
+* ܣ׷ļ
+* path: ļ·
+* void
+*   ֵ1-ɹ 0-ʧ
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+u8 TraceDumpOpen(const char *path)
+{
+	s_pTraceFile = fopen(path, "wb");
+	if(s_pTraceFile == NULL)
+	{
+		printf("ERROR:[TraceDumpOpen] Can not create %s!\r\n", path);
+		return 0;
+	}
+	s_iHdrWritten = 0;
+	return 1;
+}
+
+/*********************************************************************************************************
+* ƣTraceDumpDrain
+* ܣȡеȫ¼дļ
+* void
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺δļʱȻȡ ֤ں˻һֱڸ״̬
+*********************************************************************************************************/
+void TraceDumpDrain(void)
+{
+	u32 num;
+
+	if(s_pTraceFile != NULL && !s_iHdrWritten)
+	{
+		TraceDumpWriteHdr();
+	}
+
+	while((num = OSTraceRead(s_arrRecBuf, TRACE_READ_NUM)) != 0)
+	{
+		if(s_pTraceFile != NULL)
+		{
+			fwrite(s_arrRecBuf, sizeof(OS_TRACE_REC), num, s_pTraceFile);
+		}
+	}
+}
+
+/*********************************************************************************************************
+* ƣTraceDumpClose
+* ܣдʣ¼ ʧرļ
+* void
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺
+*********************************************************************************************************/
+void TraceDumpClose(void)
+{
+	if(s_pTraceFile == NULL)
+	{
+		return;
+	}
+
+	TraceDumpDrain();
+	s_structHdr.lost = OSTraceLostGet();
+	fseek(s_pTraceFile, 0, SEEK_SET);
+	fwrite(&s_structHdr, sizeof(s_structHdr), 1, s_pTraceFile);
+	fclose(s_pTraceFile);
+	s_pTraceFile = NULL;
+}
@@ -0,0 +1,52 @@
+/*********************************************************************************************************
+* ģƣTraceDump.h
+* ժ    Ҫں¼׷ٵļʽ뵼ӿ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260213
+*     ݣ
+*           (1) ļʽTRACE_FILE_HDR + OS_TRACE_TASK[taskNum] + OS_TRACE_REC[...] ֱļ
+*           (2) ֶΰֽд 빤 TraceDecode.c ʾͬһ
+* ע    ⣺
+*           (1) ĿϿɰͬĸʽͨ ˱ļͬһ빤߽
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+#ifndef _TRACE_DUMP_H_
+#define _TRACE_DUMP_H_
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define TRACE_FILE_MAGIC    0x43525443U  //"CTRC"
+#define TRACE_FILE_VERSION  1
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+typedef struct TRACE_FILE_HDR
+{
+	u32 magic;    //TRACE_FILE_MAGIC
+	u32 version;  //TRACE_FILE_VERSION
+	u32 freq;     //ʱƵ(Hz)
+	u32 taskNum;  //
+	u32 lost;     //ڼ䱻ǵļ¼
+}TRACE_FILE_HDR;
+
+/*********************************************************************************************************
+*                                              API
+*********************************************************************************************************/
+u8   TraceDumpOpen(const char *path);  //׷ļ ɹ1
+void TraceDumpDrain(void);             //ȡеȫ¼дļ(δļʱ)
+void TraceDumpClose(void);             //дʣ¼رļ
+
+#endif  //_TRACE_DUMP_H_
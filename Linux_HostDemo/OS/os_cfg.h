@@ -0,0 +1,94 @@
+/*********************************************************************************************************
+* ģƣos_cfg.h
+* ժ    ҪCasyOS ļܲü + ֲ
+*     1.0.0
+*     ߣChill
+*     ڣ2026-01-15
+*
+*     ;
+*   1) OSܿأڴ/ź///־飩
+*   2) OSؼȼڴشС뷽ʽ
+*
+* ֲע⣺
+*   - ļΪ Linux ã os_port_posix.c ʹã
+*   - źŴջջ谴ҪŴ
+*********************************************************************************************************/
+#ifndef _OS_CFG_H_
+#define _OS_CFG_H_
+
+/*
+* ʹñ׼ printf
+*/
+#include <stdio.h>
+
+/*
+* armcc ؼ gcc µĵȼд֤ںԴ޸ļɱ
+*/
+#define __align(x)                        __attribute__((aligned(x)))
+
+
+
+#define OS_CFG_FPU_EN                     0           //1-ʹFPU0=ر ĳЩоƬûFPUؼĴ øú궨 ʹֻܺùFPUлʱS16-S31
+
+#define OS_CFG_NVIC_PRIO_BITS             4           //оƬʵֵжȼλ(GD32F30xΪ4) Ҳõ ҪU׺
+#define OS_CFG_MAX_SYSCALL_PRIO           4           //ɵں˽ӿڵжȼ(ֵ1~2^PRIO_BITS-1) ֵСжϲٽ õκں˽ӿ
+
+#define OS_CFG_PRIO_MAX                   32          //ȼ0~OS_CFG_PRIO_MAX-1 32ʱʹõλͼ 256(λͼ)
+
+#define OS_CFG_IDLE_STK_SIZE              4096        //ջС(λu32) ź֡
+
+#define OS_CFG_SCHED_RR_EN                1           //1=ͬȼʱƬת
+#define OS_CFG_TIME_QUANTA_DEFAULT        10          //ĬʱƬ(λtick) OSTaskSetTimeQuanta޸
+
+#define OS_CFG_TICKLESS_EN                1           //1=ticklessģʽʱʱбͣڽĲ
+#define OS_CFG_TICKLESS_MIN_TICKS         2           //нСڸֵŽtickless(>=2)
+
+#ifndef OS_CFG_TICK_WHEEL_EN                                  // make и ڶԱʱб
+#define OS_CFG_TICK_WHEEL_EN              1           //1=ʱбʹùϣʱ(O(1)/ɾ)0=(O(n))
+#endif
+#define OS_CFG_TICK_WHEEL_SIZE            256         //ʱֲ(Ϊ2) ÿռһָ
+
+#define OS_CFG_TASK_NAME_EN               1           //1=ְ֧
+#define OS_CFG_TASK_FUNC_EN               1           //1=ְ֧ںַ
+#define OS_CFG_TASK_PROFILE_EN            1           //1=ͳÿʱCPUռ(ֲṩʱ)
+#define OS_CFG_TASK_STK_CHK_EN            1           //1=עʱù̶ֵջ ֲ֧ѯջʹ(ˮλ)
+#define OS_CFG_TASK_SUSPEND_EN            1           //1= OSTaskSuspend()/OSTaskResume()
+#define OS_CFG_TASK_DEL_EN                1           //1= OSTaskDelete() ʱԶɾ 0=ʱͣڳ
+
+#define OS_CFG_TRACE_EN                   1           //1=ں¼׷٣л/ж/ͬ¼λ(ֲṩʱ)
+#define OS_CFG_TRACE_BUF_SIZE             4096        //׷ٻ¼(Ϊ2) ÿ12ֽ д󸲸ɼ¼
+
+#define OS_CFG_MEM_EN                     1           //1=ڴ0=ر
+#define OS_MEM_MAX_SIZE                   20 * 1024   //ڴ(ֽ) ĬΪ20K
+#define OS_MEM_ALIGN                      8           //ڴضֽ(8ұΪ2)
+#define OS_MEM_POOL_ATTR                  (OS_MEM_ATTR_FAST | OS_MEM_ATTR_DMA)  //ڲڴ  OSMemRegionAdd ע
+#define OS_MEM_FAST_SIZE                  128         //OSMalloc ôС(ֽ)ʱڿ ȷ
+#ifndef OS_CFG_MEM_TLSF_EN                                    // make и ڶԱַ
+#define OS_CFG_MEM_TLSF_EN                1           //1=(TLSF) /ͷO(1)0=״䵥(O(n) ͷO(1))
+#endif
+#define OS_CFG_MEM_CHECK_EN               1           //1= OSMemCheck() ڴؼͷǰǷһ()
+
+#define OS_CFG_MEM_PART_EN                1           //1=ù̶ڴ(O(1)ȡ/黹 жʹ  OS_CFG_MEM_EN)
+
+#define OS_CFG_SEM_EN                     1           //1=ź
+
+#define OS_CFG_Q_EN                       1           //1=ϢÿϢ̶4ֽu32
+#define OS_CFG_Q_FLUSH_EN                 1           //1= OSQFlush()
+
+#define OS_CFG_TASK_NOTIFY_EN             1           //1=֪ͨÿһ32λֵ֪ͨ ҪбͶ̬ڴ
+
+#define OS_CFG_MUTEX_EN                   1           //1=û
+#define OS_CFG_MUTEX_PI_EN                1           //1=ȼ̳(֧Ƕ׳봫ݼ̳)
+
+#define OS_CFG_FLAG_EN                    1           //1=¼־
+
+#define OS_CFG_TMR_EN                     1           //1=ʱ(Ҫ OS_CFG_SEM_EN)
+#define OS_CFG_TMR_TASK_PRIO              1           //ʱȼ жʱصڸִ
+#define OS_CFG_TMR_TASK_STK_SIZE          4096        //ʱջС(λu32) Ļص
+
+#define OS_CFG_DEFER_EN                   1           //1=жӺУжֻǼǺɷִ(ֲṩʱ)
+#define OS_CFG_DEFER_Q_SIZE               16          //Ӻ(Ϊ2) ʱǼʧܲ
+#define OS_CFG_DEFER_TASK_PRIO            0           //Ӻȼ Ϊȼ
+#define OS_CFG_DEFER_TASK_STK_SIZE        4096        //ӺջС(λu32) Ĵ
+
+#endif  //_OS_CFG_H_
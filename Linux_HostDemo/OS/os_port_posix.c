@@ -0,0 +1,514 @@
+/*********************************************************************************************************
+* ģƣos_port_posix.c
+* ժ    ҪCasyOS Linux ֲ㣨Ŀ//عں˶
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260202
+*     ݣ
+*           (1) ģÿ ucontext_t ջstackTop ָ
+*                Cortex-M  stackTop ָջбļĴֳһ£
+*           (2) SysTickITIMER_REAL ʱÿ 1ms  SIGALRMźŴе SysTick_Handler()
+*           (3) жϣSIGUSR1 ΪжϣǶ SysTick ֮
+*           (4) PendSV"־ + "ģ⣬ֻж˳/̬жʱִл
+*           (5) ٽ PRIMASKٽڵźű¼˳ٽʱ
+*           (6) tickless ITIMER_REAL Ϊζʱ sigsuspend ߣӦ WFIѺָڶʱ
+* ע    ⣺
+*           (1) ںԴ루CasyOS.c/os_task.c/os_sem.c ȣκ޸ģ滻 os_port_cm.c
+*           (2) ж(źŴ)ڱջϣûжжջ
+*               ÿջź֡жǶ׵Ŀռ䣬ÿջС 16KB
+*           (3) ٽ sigprocmaskΪڴд perf/valgrind ںȵ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "os_port_posix.h"
+#include <signal.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define OS_PORT_TICK_PERIOD_US	1000																		//ϵͳ(us)
+#define OS_PORT_CTX_SIZE				((sizeof(ucontext_t) + 15) & ~(uintptr_t)15)	//ջĴС(16ֽڶ)
+#define OS_PORT_STK_MIN					(16 * 1024)															//ջСֵ(ֽ)
+#define OS_PORT_IRQ_TICK				(1 << 0)																//SysTick λ
+#define OS_PORT_IRQ_USER				(1 << 1)																//жϹλ
+#define OS_PORT_TICKLESS_MAX		(60 * 1000)															//tickless߽
+
+#define OS_PORT_BARRIER()				__asm__ __volatile__("" ::: "memory")	//
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+extern OS_TASK_HANDLE* volatile g_pCurrentTask;
+
+static sigset_t s_IrqSigSet;											//зжź
+static volatile sig_atomic_t s_Primask = 0;				//PRIMASK 1-ж
+static volatile sig_atomic_t s_CriticalNestCnt = 0;	//ٽǶײ
+static volatile sig_atomic_t s_IrqPending = 0;		//ٽбƳٵж
+static volatile sig_atomic_t s_ExcNestCnt = 0;		//쳣Ƕײ(0ʾ̬)
+static volatile sig_atomic_t s_PendSVPending = 0;	//PendSV־
+static void (*s_pUserIrqHandler)(void) = NULL;		//жϷ
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void PortInitSigSet(void);						//ʼжźż
+static void PortTaskEntry(void);						//
+static void PortIrqDispatch(int irq);				//ִһηж
+static void PortSignalHandler(int sig);			//źŴ
+static void PortPendSVService(void);				//PendSVһл
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣPortInitSigSet
+* ܣʼжźż
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺ظ
+*********************************************************************************************************/
+static void PortInitSigSet(void)
+{
+	sigemptyset(&s_IrqSigSet);
+	sigaddset(&s_IrqSigSet, SIGALRM);
+	sigaddset(&s_IrqSigSet, SIGUSR1);
+}
+
+/*********************************************************************************************************
+* ƣPortTaskEntry
+* ܣ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*           (1) һʱ setcontext/swapcontext תʱ g_pCurrentTask Ϊ
+*           (2) Ǵ̬ʼУлµ쳣жź
+*           (3) غں˳ OS_TaskReturn Cortex-M ʼջ֡ LR öӦ
+*********************************************************************************************************/
+static void PortTaskEntry(void)
+{
+	s_ExcNestCnt = 0;
+	s_CriticalNestCnt = 0;
+	s_Primask = 0;
+	sigprocmask(SIG_UNBLOCK, &s_IrqSigSet, NULL);
+
+	((void (*)(void))g_pCurrentTask->func)();
+
+	OS_TaskReturn();
+}
+
+/*********************************************************************************************************
+* ƣPortIrqDispatch
+* ܣִһηжϷ
+* irq: OS_PORT_IRQ_TICK / OS_PORT_IRQ_USER
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺ж˳ʱ PendSV ڴлӦ Cortex-M ҧβ PendSV
+*********************************************************************************************************/
+static void PortIrqDispatch(int irq)
+{
+	s_ExcNestCnt++;
+	if(irq == OS_PORT_IRQ_TICK)
+	{
+		SysTick_Handler();
+	}
+	else if(s_pUserIrqHandler != NULL)
+	{
+		s_pUserIrqHandler();
+	}
+	s_ExcNestCnt--;
+
+	if(s_ExcNestCnt == 0 && s_PendSVPending)
+	{
+		PortPendSVService();
+	}
+}
+
+/*********************************************************************************************************
+* ƣPortSignalHandler
+* ܣSIGALRM/SIGUSR1 źŴ
+* sig: źű
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺ٽʱֻ¼λ OS_EXIT_CRITICAL 
+*********************************************************************************************************/
+static void PortSignalHandler(int sig)
+{
+	int irq = (sig == SIGALRM) ? OS_PORT_IRQ_TICK : OS_PORT_IRQ_USER;
+
+	if(s_Primask)
+	{
+		s_IrqPending |= irq;
+		return;
+	}
+	PortIrqDispatch(irq);
+}
+
+/*********************************************************************************************************
+* ƣPortPendSVService
+* ܣPendSV 浱ǰĲлȼ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*           (1) ֻ ̬  δж ʱ
+*           (2) ͣ swapcontext ָʱ
+*           (3) лڼ쳣+1ڼ䵽жֻ PendSV л
+*********************************************************************************************************/
+static void PortPendSVService(void)
+{
+	OS_TASK_HANDLE* pPrevTask;
+
+	s_ExcNestCnt++;
+	s_PendSVPending = 0;
+
+	pPrevTask = g_pCurrentTask;
+	OS_UpdateCurrentTask();
+	if(g_pCurrentTask != pPrevTask)
+	{
+		swapcontext((ucontext_t*)pPrevTask->stackTop, (ucontext_t*)g_pCurrentTask->stackTop);
+	}
+
+	s_ExcNestCnt--;
+	if(s_ExcNestCnt == 0 && s_PendSVPending && !s_Primask)
+	{
+		PortPendSVService();
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_PortStkInit
+* ܣʼ
+* p_tcb: ƿָ루stackBase/stackSize/func д
+* p_tcb->stackTop: ָ򱣴ջ ucontext_t
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺û  OSRegister ʹ
+*********************************************************************************************************/
+void OS_PortStkInit(OS_TASK_HANDLE* p_tcb)
+{
+	u8* base;
+	u8* top;
+	ucontext_t* ctx;
+
+	PortInitSigSet();
+
+	base = (u8*)p_tcb->stackBase;
+	top  = (u8*)((uintptr_t)(base + p_tcb->stackSize * 4) & ~(uintptr_t)15);
+	ctx  = (ucontext_t*)(top - OS_PORT_CTX_SIZE);
+
+	if(p_tcb->stackSize * 4 < OS_PORT_STK_MIN)
+	{
+		printf("Warning: [OS_PortStkInit] Stack of %s May Be Too Small For Host!\r\n", p_tcb->taskName);
+	}
+
+	getcontext(ctx);
+	ctx->uc_stack.ss_sp   = base;
+	ctx->uc_stack.ss_size = (u8*)ctx - base;
+	ctx->uc_link          = NULL;
+	ctx->uc_sigmask       = s_IrqSigSet;	//ٴжź
+	makecontext(ctx, PortTaskEntry, 0);
+
+	p_tcb->stackTop = (u32*)ctx;
+}
+
+/*********************************************************************************************************
+* ƣOS_PortStartFirstTask
+* ܣװźŴĶʱлһ
+* void
+* void
+*   ֵvoidأ
+* ڣ20260202
+* ע    ⣺main ı Cortex-M  SVC ٷ main һ
+*********************************************************************************************************/
+void OS_PortStartFirstTask(void)
+{
+	struct sigaction sa;
+	struct itimerval timer;
+
+	PortInitSigSet();
+	sigprocmask(SIG_BLOCK, &s_IrqSigSet, NULL);	//һǰӦж
+
+	//SysTick жǶ
+	sa.sa_handler = PortSignalHandler;
+	sa.sa_flags   = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, NULL);
+
+	//жִڼ SysTick
+	sigaddset(&sa.sa_mask, SIGALRM);
+	sigaction(SIGUSR1, &sa, NULL);
+
+	timer.it_interval.tv_sec  = 0;
+	timer.it_interval.tv_usec = OS_PORT_TICK_PERIOD_US;
+	timer.it_value            = timer.it_interval;
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	OS_UpdateCurrentTask();
+	setcontext((ucontext_t*)g_pCurrentTask->stackTop);
+}
+
+/*********************************************************************************************************
+* ƣOS_PortPendSVTrigger
+* ܣPendSV һл
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺̬δжʱлƳٵж˳ OS_EXIT_CRITICAL
+*********************************************************************************************************/
+void OS_PortPendSVTrigger(void)
+{
+	s_PendSVPending = 1;
+	if(s_ExcNestCnt == 0 && !s_Primask)
+	{
+		PortPendSVService();
+	}
+}
+
+/*********************************************************************************************************
+* ƣOS_ENTER_CRITICAL
+* ܣٽ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*           (1) ֧Ƕ  Cortex-M  BASEPRI ʵһ
+*           (2) ֻһж ȫٽ ӳж
+*********************************************************************************************************/
+void OS_ENTER_CRITICAL(void)
+{
+	s_Primask = 1;
+	OS_PORT_BARRIER();
+	s_CriticalNestCnt++;
+}
+
+/*********************************************************************************************************
+* ƣOS_EXIT_CRITICAL
+* ܣ˳ٽ
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*           (1) ֻ˳ʱŴж  Cortex-M  BASEPRI ʵһ
+*           (2) ٽڱƳٵжϣڼʵźţͬһжǶ
+*********************************************************************************************************/
+void OS_EXIT_CRITICAL(void)
+{
+	sigset_t oldMask;
+	int irq;
+
+	if(s_CriticalNestCnt == 0)
+	{
+		printf("ERROR:[OS_EXIT_CRITICAL] Not in critical section!\r\n");
+		return;
+	}
+	s_CriticalNestCnt--;
+	if(s_CriticalNestCnt != 0)
+	{
+		return;
+	}
+
+	OS_PORT_BARRIER();
+	s_Primask = 0;
+
+	if(s_IrqPending)
+	{
+		sigprocmask(SIG_BLOCK, &s_IrqSigSet, &oldMask);
+		irq = s_IrqPending;
+		s_IrqPending = 0;
+		if(irq & OS_PORT_IRQ_USER)
+		{
+			PortIrqDispatch(OS_PORT_IRQ_USER);
+		}
+		if(irq & OS_PORT_IRQ_TICK)
+		{
+			PortIrqDispatch(OS_PORT_IRQ_TICK);
+		}
+		sigprocmask(SIG_SETMASK, &oldMask, NULL);
+	}
+
+	if(s_ExcNestCnt == 0 && s_PendSVPending)
+	{
+		PortPendSVService();
+	}
+}
+
+#if OS_PORT_TIMESTAMP_EN != 0
+/*********************************************************************************************************
+* ƣOS_PortTimestampGet
+* ܣȡʱ
+* void
+* void
+*   ֵʱ(us) ضΪ32λ
+* ڣ20260211
+* ע    ⣺Ӧ Cortex-M  DWT CYCCNT Լ71ӻһ ̱ȳȥʱҲ
+*********************************************************************************************************/
+u32 OS_PortTimestampGet(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u32)((u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000);
+}
+
+/*********************************************************************************************************
+* ƣOS_PortTimestampFreq
+* ܣȡʱƵ
+* void
+* void
+*   ֵ1000000(Hz)
+* ڣ20260211
+* ע    ⣺
+*********************************************************************************************************/
+u32 OS_PortTimestampFreq(void)
+{
+	return 1000000;
+}
+#endif	//OS_PORT_TIMESTAMP_EN
+
+/*********************************************************************************************************
+* ƣOS_PortSetIrqHandler
+* ܣעжϷ
+* handler: жϷе OSIntEnter/OSIntExit
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺
+*********************************************************************************************************/
+void OS_PortSetIrqHandler(void (*handler)(void))
+{
+	s_pUserIrqHandler = handler;
+}
+
+/*********************************************************************************************************
+* ƣOS_PortRaiseIrq
+* ܣһηж
+* void
+* void
+*   ֵvoid
+* ڣ20260202
+* ע    ⣺еʱжϷ raise ǰִ
+*********************************************************************************************************/
+void OS_PortRaiseIrq(void)
+{
+	raise(SIGUSR1);
+}
+
+#if OS_CFG_TICKLESS_EN != 0
+/*********************************************************************************************************
+* ƣOS_PortTicklessSleep
+* ܣͣڽ ζʱticksĺ
+* ticks: ߵĽ(>=2)  OS_PORT_TICKLESS_MAX ʱض
+* void
+*   ֵҪں˲ǵ
+* ڣ20260205
+* ע    ⣺
+*           (1) ٽڵãڼ䵽źֻ¼λѽ̴ sigsuspend л
+*           (2) ˯ʱ SysTick ѹ䲹һģֻ ticks-1
+*           (3) жǰʱʱʣʱģһ SysTick 뵽ԭı߽
+*           (4) йжʱߣֱӷ 0
+*********************************************************************************************************/
+u32 OS_PortTicklessSleep(u32 ticks)
+{
+	struct itimerval timer;
+	sigset_t oldMask;
+	sigset_t waitMask;
+	u64 firstUs;			//һı߽ʱ
+	u64 totalUs;			//εζʱʱ
+	u64 leftUs;				//ʱʱʣʱ
+	u64 elapsedUs;		//ʵʱ
+	u32 sleptTicks;		//ʵʾ
+
+	if(ticks > OS_PORT_TICKLESS_MAX)
+	{
+		ticks = OS_PORT_TICKLESS_MAX;
+	}
+
+	//ʵź ֤"λ-"֮䲻ᶪʧ
+	sigprocmask(SIG_BLOCK, &s_IrqSigSet, &oldMask);
+	if(s_IrqPending)
+	{
+		sigprocmask(SIG_SETMASK, &oldMask, NULL);
+		return 0;
+	}
+
+	//ԵǰĵʣʱΪ ӳ ticks-1  ζʱ
+	getitimer(ITIMER_REAL, &timer);
+	firstUs = (u64)timer.it_value.tv_sec * 1000000 + timer.it_value.tv_usec;
+	if(firstUs == 0 || firstUs > OS_PORT_TICK_PERIOD_US)
+	{
+		firstUs = OS_PORT_TICK_PERIOD_US;
+	}
+	totalUs = firstUs + (u64)(ticks - 1) * OS_PORT_TICK_PERIOD_US;
+	timer.it_interval.tv_sec  = 0;
+	timer.it_interval.tv_usec = 0;
+	timer.it_value.tv_sec     = totalUs / 1000000;
+	timer.it_value.tv_usec    = totalUs % 1000000;
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	// ֱһжϵ(Ӧ WFI)
+	waitMask = oldMask;
+	sigdelset(&waitMask, SIGALRM);
+	sigdelset(&waitMask, SIGUSR1);
+	while(!s_IrqPending)
+	{
+		sigsuspend(&waitMask);
+	}
+
+	getitimer(ITIMER_REAL, &timer);
+	leftUs = (u64)timer.it_value.tv_sec * 1000000 + timer.it_value.tv_usec;
+
+	if(s_IrqPending & OS_PORT_IRQ_TICK)
+	{
+		//˯SysTick ѹ һһں
+		sleptTicks = ticks - 1;
+		timer.it_value.tv_sec  = 0;
+		timer.it_value.tv_usec = OS_PORT_TICK_PERIOD_US;
+	}
+	else
+	{
+		//жǰѣ һĶ뵽ԭı߽
+		elapsedUs  = totalUs - leftUs;
+		sleptTicks = (elapsedUs < firstUs) ? 0 : (u32)(1 + (elapsedUs - firstUs) / OS_PORT_TICK_PERIOD_US);
+		timer.it_value.tv_sec  = 0;
+		timer.it_value.tv_usec = leftUs % OS_PORT_TICK_PERIOD_US;
+		if(timer.it_value.tv_usec == 0)
+		{
+			timer.it_value.tv_usec = OS_PORT_TICK_PERIOD_US;
+		}
+	}
+
+	//ָڽ
+	timer.it_interval.tv_sec  = 0;
+	timer.it_interval.tv_usec = OS_PORT_TICK_PERIOD_US;
+	setitimer(ITIMER_REAL, &timer, NULL);
+
+	sigprocmask(SIG_SETMASK, &oldMask, NULL);
+
+	return sleptTicks;
+}
+#endif	//OS_CFG_TICKLESS_EN
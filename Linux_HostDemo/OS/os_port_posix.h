@@ -0,0 +1,32 @@
+/*********************************************************************************************************
+* ģƣos_port_posix.h
+* ժ    ҪCasyOS Linux ֲչӿ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260202
+*     ݣ
+*           (1) жϣģ USART жϵ OSIntEnter/OSIntExit
+* ע    ⣺
+*           (1) ʹãCortex-M ̲Ҫļ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+#ifndef _OS_PORT_POSIX_H_
+#define _OS_PORT_POSIX_H_
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+/*********************************************************************************************************
+*                                              API
+*********************************************************************************************************/
+void OS_PortSetIrqHandler(void (*handler)(void));	//עжϷ
+void OS_PortRaiseIrq(void);												//һηж(SIGUSR1)
+
+#endif	//_OS_PORT_POSIX_H_
@@ -6,13 +6,12 @@
 * ڣ20260131
 *     ݣ
 *           (1) RTOSں˺ģȴлжǶ׹
-*           (2) 쳣ڣSysTick / SVC / PendSV
-*           (3) ṩϵͳٽʱȻӿ
+*           (2) ڣSysTick
+*           (3) ṩϵͳעᡢʱȻӿ
 * ע    ⣺
 *           (1) ļһ㲻û޸
-*           (2) л PendSV 쳣״ SVC 쳣
+*           (2) ļоƬں޹أջ֡/л/ٽֲ os_port_xxx.c ʵ
 *           (3) SysTick ΪϵͳʱӣOS TickƵӰʱȿ
-*						(4) ȫж϶ʹMSPջָ δʵPSPջ
 **********************************************************************************************************
 * ȡ汾
 *     ߣ
@@ -29,7 +28,6 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
-#define PENDSV_TRIGGER (*(u32*)0xE000ED04 |= 0x10000000)	//PENDSV쳣 ̵
 #define OS_MAX_TIME (u64)(0xFFFFFFFFFFFFFFFF)	//ʱʱ䣬ʹ64λʱÿ1msʱһ
 #define OS_MAX_TASK (u32)(10)	//
 
@@ -40,10 +38,12 @@
 OS_TASK_HANDLE* volatile g_pCurrentTask = NULL;	//ǰִе
 volatile u8 g_OSIntNestCnt = 0;									//жǶ׼(>0 ʾж)
 volatile u8 g_OSSchedFlag = 0;									//ǷҪл־(1ʾҪһл)
+volatile u8 g_OSSchedLockNestCnt = 0;						//Ƕ׼(>0 ʾֹл)
 
 //̬
-static u32 s_arrIdleStack[64];									//ջ
+static u32 s_arrIdleStack[OS_CFG_IDLE_STK_SIZE];	//ջ
 static OS_TASK_HANDLE s_structIdleHandle;				//
+static volatile u32 s_OSWakeupCnt = 0;					//SysTickжۼƴ(ÿνжϼCPUһ)
 
 /*********************************************************************************************************
 *                                              ڲ
@@ -66,13 +66,53 @@ static void IdleTask(void);	//
 * ڣ20260131
 * ע    ⣺
 *           (1) ڱ֤ϵͳʼ
-*           (2) TODO: ڴ˴չ CPU ͳ / ͹Ĵȹ
+*           (2) tickless ģʽʱб(ʱ)ĵʱΪʱֲͣڽĺߣ
+*               Ѻڼ侭һԲǵʱбһɹSysTickжϲ
+*           (3) ж--ǹٽɣԴж˳ٽִ
 *********************************************************************************************************/
 static void IdleTask(void)
 {
+#if OS_CFG_TICKLESS_EN != 0
+	u64 idleTicks;	//һʱڵĽ
+	u32 sleptTicks;	//ʵߵ
+#if OS_CFG_TMR_EN != 0
+	u64 tmrTicks;		//һʱڵĽ
+#endif
+#endif
+
 	while(1)
 	{
+#if OS_CFG_TICKLESS_EN != 0
+		OS_ENTER_CRITICAL();
+		
+		//ֻпʱ
+		if(OS_BitMapGetHighest() == s_structIdleHandle.priority)
+		{
+			idleTicks = OS_TickGetNextWakeup();
+#if OS_CFG_TMR_EN != 0
+			tmrTicks = OS_TmrGetNextWakeup();
+			if(tmrTicks != 0 && (idleTicks == 0 || tmrTicks < idleTicks))
+			{
+				idleTicks = tmrTicks;
+			}
+#endif
+			if(idleTicks == 0 || idleTicks > 0xFFFFFFFF)	//ûʱʱֲʱ
+			{
+				idleTicks = 0xFFFFFFFF;
+			}
+			
+			if(idleTicks >= OS_CFG_TICKLESS_MIN_TICKS)
+			{
+				sleptTicks = OS_PortTicklessSleep((u32)idleTicks);
+				OS_TickUpdateBatch(sleptTicks);
+#if OS_CFG_TMR_EN != 0
+				OS_TmrTickUpdate();
+#endif
+			}
+		}
 		
+		OS_EXIT_CRITICAL();
+#endif
 	} 
 }
 
@@ -89,14 +129,15 @@ static void IdleTask(void)
 * ע    ⣺
 *           (1) ̬ã PendSV 쳣л
 *           (2) ж̬ãλ g_OSSchedFlag OSIntExit ͳһ PendSV
-*           (3) ûӿڣںģʹ
+*           (3) ʱλ g_OSSchedFlag OSSchedUnlock  PendSV
+*           (4) ûӿڣںģʹ
 *********************************************************************************************************/
 void OS_Sched(void)
 {
 	g_OSSchedFlag = 1;
-	if(OS_InISR() == 0)
+	if(OS_InISR() == 0 && g_OSSchedLockNestCnt == 0)
 	{
-		PENDSV_TRIGGER;
+		OS_PortPendSVTrigger();
 	}
 }
 
@@ -111,113 +152,25 @@ void OS_Sched(void)
 *           (1) úжãΪ static
 *           (2) SysTick ΪϵͳʱӣάʱʱƬȻ
 *           (3) жڲֱл񣬶Ǵ
+*           (4) ֻȼǵǰʱȣнĲ PendSV
 *********************************************************************************************************/
 void SysTick_Handler(void)
 {
 	OSIntEnter();
+	s_OSWakeupCnt++;
 	OS_TickUpdate();	//tickݼ 
-
-	OS_Sched();				//쳣 л
-	OSIntExit();
-}
-
-/*********************************************************************************************************
-* ƣSVC_Handler
-* ܣSVC_HandlerжϷ
-* void
-* void
-*   ֵvoid
-* ڣ20260131
-* ע    ⣺
-*           (1) úжãΪ static
-*           (2) Ҫϵͳ״ʱָһ
-*           (3) ʵ OS_UpdateCurrentTask() ѡȼ
-*********************************************************************************************************/
-__ASM void SVC_Handler(void)
-{
-	PRESERVE8                		//öʼַ8ֽڶ
-	IMPORT OS_UpdateCurrentTask //OS_UpdateCurrentTask
-	IMPORT g_pCurrentTask    		//g_pCurrentTask
-
-	//ж
-	CPSID F
-	
-	//ȼߵ񣬸µg_pCurrentTask
-	BL OS_UpdateCurrentTask
-	
-	//ָһջָ(ṹһԱΪջָ)
-	LDR R4,= g_pCurrentTask  //ȡg_pCurrentTaskĵַ浽R4
-	LDR R5, [R4]             //ȡg_pCurrentTaskݣǰ׵ַ浽R5
-	LDR SP, [R5]             //ȡ׵ַ4ֽݣ浽ջָ
-	
-	//ָһԤֳ
-	POP{R4-R11}              //ָR4-R11
-#if OS_CFG_FPU_EN != 0
-	VPOP{S16-S31}            //ָS16-S31
-#endif
-	POP{LR}                  //ָLR
-	
-	//ȡж
-	CPSIE F
-	
-	//쳣˳
-	BX LR
-	NOP
-}
-
-/*********************************************************************************************************
-* : PendSV_Handler
-* : PendSVжϷʵл
-* : void
-* : void
-*   ֵ: void
-* : 20260131
-* ע    : 
-*           (1) ʹõҲMSPPendSV_HandlerжãΪڲ
-*           (2) PendSV ȼʺл
-*           (3) Cortex-M ӲԶ R0-R3R12LRPCxPSRĴ
-*********************************************************************************************************/
-__ASM void PendSV_Handler(void)
-{
-  PRESERVE8                			//öʼַ8ֽڶ
-  IMPORT OS_UpdateCurrentTask		//OS_UpdateCurrentTask
-  IMPORT g_pCurrentTask    			//g_pCurrentTask
-
-  //ж
-  CPSID F
-
-  //浱ǰֳ(xPSRPCLRR12ԼR3~R0ѾԶ)
-  PUSH{LR}                 //LRջ
-#if OS_CFG_FPU_EN != 0
-  VPUSH{S16-S31}           //S16-S31ջ
+#if OS_CFG_TMR_EN != 0
+	OS_TmrTickUpdate();	//ʱڼ
 #endif
-  PUSH{R4-R11}             //R4-R11ջ
-
-  //浱ǰջָ(ṹһԱΪջָ)
-  LDR R4,= g_pCurrentTask  //ȡg_pCurrentTaskĵַ浽R4
-  LDR R5, [R4]             //ȡg_pCurrentTaskݣǰ׵ַ浽R5
-  STR SP, [R5]             //ջ ָ밴ֱ浽ʼλãOS_TASK_HANDLEṹһԱ
-  
-  //ʱͲȼߵ
-  BL OS_UpdateCurrentTask
-
-  //ָһջָ(ṹһԱΪջָ)
-  LDR R4,= g_pCurrentTask  //ȡg_pCurrentTaskĵַ浽R4
-  LDR R5, [R4]             //ȡg_pCurrentTaskݣǰ׵ַ浽R5
-  LDR SP, [R5]             //ȡ׵ַ4ֽݣ浽ջָ
-  
-  //ָһֳ
-  POP{R4-R11}              //ָR4-R11
-#if OS_CFG_FPU_EN != 0
-  VPOP{S16-S31}            //ָS16-S31
+#if OS_CFG_SCHED_RR_EN != 0
+	OS_SchedRoundRobin();	//ͬȼʱƬת
 #endif
-  POP{LR}                  //ָLR
 
-  //ȡж
-  CPSIE F 
-
-  //쳣˳
-  BX LR
+	if(OS_SchedNeeded())	//иȼʱƬת
+	{
+		OS_Sched();			//쳣 л
+	}
+	OSIntExit();
 }
 
 /*********************************************************************************************************
@@ -240,6 +193,12 @@ void InitCasyOS(void)
 {
 	OSInitMemory();			//ʼCasyOSڴģ
 	OSInitTaskSched();	//ʼCasyOSģ
+#if OS_CFG_TMR_EN != 0
+	OS_TmrInit();				//ʼʱ(עᶨʱ)
+#endif
+#if OS_CFG_DEFER_EN != 0
+	OS_DeferInit();			//ʼжӺ(ע)
+#endif
 }
 
 /*********************************************************************************************************
@@ -256,12 +215,13 @@ void InitCasyOS(void)
 * void
 *   ֵ0-ɹ-ʧ
 * ڣ20260131
-* ע    ⣺עܴOS_MAX_TASK
+* ע    ⣺
+*           (1) עܴOS_MAX_TASK
+*           (2) ϵͳҲԵ  OSTaskDelete ɾͬһ TCB ջע
 *********************************************************************************************************/
 u32 OSRegister(OS_TASK_HANDLE* p_tcb, void* func, char *p_name, u32 prio, u32* stkBase, u32 stkSize, u32 semSize, u32 queSize)
 {
   u32  i;   //ѭ
-  u32* top; //ջַ
   
 	//Ĭ
 	p_tcb->stackBase = stkBase;
@@ -269,61 +229,73 @@ u32 OSRegister(OS_TASK_HANDLE* p_tcb, void* func, char *p_name, u32 prio, u32* s
 	p_tcb->func      = (void (*)(void *))func;
 	p_tcb->taskName      = p_name;
 	p_tcb->priority      = prio;
+	p_tcb->basePriority  = prio;
+	p_tcb->state         = OS_TASK_READY;
+	p_tcb->pendObj       = NULL;
 	p_tcb->tick = 0;
 	p_tcb->rdyNextPtr = NULL;
 	p_tcb->rdyPrevPtr = NULL;
 	p_tcb->tickNextPtr = NULL;
 	p_tcb->tickPrevPtr = NULL;
+	p_tcb->pendNextPtr = NULL;
+	p_tcb->pendPrevPtr = NULL;
+#if OS_CFG_SCHED_RR_EN != 0
+	p_tcb->timeQuanta = OS_CFG_TIME_QUANTA_DEFAULT;
+#endif
+#if OS_CFG_TASK_SUSPEND_EN != 0
+	p_tcb->suspended = 0;
+#endif
+#if OS_MUTEX_HELD_EN != 0
+	p_tcb->mutexHeldPtr = NULL;
+#endif
+#if OS_CFG_TASK_PROFILE_EN != 0
+	p_tcb->runTime = 0;
+	p_tcb->runTimeSnap = 0;
+	p_tcb->switchCnt = 0;
+#endif
+#if OS_CFG_TRACE_EN != 0
+	p_tcb->traceId = OS_TraceTaskIdAlloc();
+#endif
 	
+#if OS_CFG_TASK_STK_CHK_EN != 0
+  //ջ̶ֵ ͳջʹøˮλ
+  for(i = 0; i < stkSize; i++)
+  {
+    p_tcb->stackBase[i] = OS_TASK_STK_PATTERN;
+  }
+#else
   //ջ
   for(i = 0; i < stkSize; i++)
   {
     p_tcb->stackBase[i] = 0;
   }
-
-	//ȡջ8ֽڶ
-	top = (u32*)(p_tcb->stackBase + p_tcb->stackSize); 
-	top = (u32*)((u32)top & ~0x07);
-
-	/*--------ӲԶָ--------*/
-	*(--top) = 0x01000000;          //xPSR
-	*(--top) = (u32)p_tcb->func;    //PC
-	*(--top) = 0xFFFFFFFEUL;        //LRǷأ
-	*(--top) = 0x12121212;          //R12
-	*(--top) = 0x03030303;          //R3
-	*(--top) = 0x02020202;          //R2
-	*(--top) = 0x01010101;          //R1
-	*(--top) = 0x00000000;          //R0
-
-	/*-------------------*/
-	*(--top) = 0xFFFFFFF9UL;        //EXC_RETURN
-
-#if OS_CFG_FPU_EN != 0
-	for(i = 0; i < 16; i++)
-	{
-		*(--top) = 0;
-	}
 #endif
 
-	*(--top) = 0x11111111;          //R11
-	*(--top) = 0x10101010;          //R10
-	*(--top) = 0x09090909;          //R9
-	*(--top) = 0x08080808;          //R8
-	*(--top) = 0x07070707;          //R7
-	*(--top) = 0x06060606;          //R6
-	*(--top) = 0x05050505;          //R5
-	*(--top) = 0x04040404;          //R4
-
-	p_tcb->stackTop = top;
+	//ʼջ֡(ֲʵ)
+	OS_PortStkInit(p_tcb);
 
-	OS_TaskListAdd(p_tcb);				//뵽ȫ
 #if OS_CFG_SEM_EN != 0
 	OS_SemInit(&p_tcb->sem, semSize);	//ʼڽź
 #endif
 #if OS_CFG_Q_EN != 0
 	OS_QInit(p_tcb, queSize);			//ʼڽϢ
 #endif
+#if OS_CFG_TASK_NOTIFY_EN != 0
+	OS_TaskNotifyInit(p_tcb);			//ʼ֪ͨ
+#endif
+#if OS_CFG_MEM_PART_EN != 0
+	p_tcb->memPartBlk = NULL;			//ûеȴеڴ
+#endif
+
+	OS_ENTER_CRITICAL();
+	OS_TaskListAdd(p_tcb);				//뵽ȫ
 	OS_RdyTaskAdd(p_tcb);					//뵽бȼλͼ
+	OS_EXIT_CRITICAL();
+
+	if(g_pCurrentTask != NULL)		//ϵͳ ȼʱ
+	{
+		OS_Sched();
+	}
 
   return 0;	//ɹ
 }
@@ -335,59 +307,40 @@ u32 OSRegister(OS_TASK_HANDLE* p_tcb, void* func, char *p_name, u32 prio, u32* s
 * void
 *   ֵvoid
 * ڣ20260131
-* ע    ⣺޸ϵͳʱƵ
+* ע    ⣺ϵͳƵֲ OS_PortStartFirstTask() 
 *********************************************************************************************************/
 void OSStart(void)
 {
-  SCB->CCR |= SCB_CCR_STKALIGN_Msk;        //ʹ˫ջ
   OSRegister(&s_structIdleHandle, IdleTask, "IdleTask", OS_CFG_PRIO_MAX-1, s_arrIdleStack, sizeof(s_arrIdleStack)/4, 0, 0);	//ע
-  SysTick_Config(SystemCoreClock / 1000U); //ϵͳδʱ1msжһ
-  NVIC_SetPriority(SysTick_IRQn, 0x00U);   //SysTickȼ
-  NVIC_SetPriority(SVCall_IRQn, 0x01U);    //SVCȼ
-  NVIC_SetPriority(PendSV_IRQn, 0xFFU);    //PendSVȼСȼ
-  __ASM("SVC #0x03");                      //һ
-}
-
-/*********************************************************************************************************
-* ƣOS_ENTER_CRITICAL
-* ܣٽ
-* timeʱʱms
-* void
-*   ֵvoid
-* ڣ20260131
-* ע    ⣺в֧Ƕ
-*********************************************************************************************************/
-void OS_ENTER_CRITICAL(void)
-{
-	__disable_irq();
+  OS_PortStartFirstTask();	//ϵͳĲһ
 }
 
 /*********************************************************************************************************
-* ƣOS_EXIT_CRITICAL
-* ܣ˳ٽ
+* ƣOS_InISR
+* ܣжǷж
 * timeʱʱms
 * void
 *   ֵvoid
 * ڣ20260131
-* ע    ⣺в֧Ƕ
+* ע    ⣺û ںʹ
 *********************************************************************************************************/
-void OS_EXIT_CRITICAL(void)
+u8 OS_InISR(void)
 {
-	__enable_irq();
+	return (g_OSIntNestCnt > 0);
 }
 
 /*********************************************************************************************************
-* ƣOS_InISR
-* ܣжǷж
-* timeʱʱms
+* ƣOS_SchedIsLocked
+* ܣжϵǷ
+* void
 * void
-*   ֵvoid
-* ڣ20260131
-* ע    ⣺û ںʹ
+*   ֵ1- 0-δ
+* ڣ20260214
+* ע    ⣺û ӿھݴ˾ܾڼǰ
 *********************************************************************************************************/
-u8 OS_InISR(void)
+u8 OS_SchedIsLocked(void)
 {
-	return (g_OSIntNestCnt > 0);
+	return (g_OSSchedLockNestCnt > 0);
 }
 
 /*********************************************************************************************************
@@ -403,6 +356,7 @@ void OSIntEnter(void)
 {
 	OS_ENTER_CRITICAL();
 	g_OSIntNestCnt++;
+	OS_TRACE(OS_TRACE_ISR_ENTER, NULL, g_OSIntNestCnt);
 	OS_EXIT_CRITICAL();
 }
 
@@ -419,14 +373,90 @@ void OSIntExit(void)
 {
 	OS_ENTER_CRITICAL();
 	g_OSIntNestCnt--;
-	if (g_OSIntNestCnt == 0 && g_OSSchedFlag == 1)
+	OS_TRACE(OS_TRACE_ISR_EXIT, NULL, g_OSIntNestCnt);
+	if (g_OSIntNestCnt == 0 && g_OSSchedFlag == 1 && g_OSSchedLockNestCnt == 0)
 	{
 		g_OSSchedFlag = 0;
-		PENDSV_TRIGGER;
+		OS_PortPendSVTrigger();
+	}
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSSchedLock
+* ܣ
+* void
+* void
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺
+*           (1) ڼжճӦ Post Ȳճ޸Ķ;б ֻƳл
+*           (2) Ƕ 255  OSSchedUnlock ɶԵ
+*           (3) ڼ䲻ûǰĽӿ(OSDelay/ҪȴPend)
+*           (4) же
+*********************************************************************************************************/
+void OSSchedLock(void)
+{
+	if(OS_InISR())
+	{
+		printf("ERROR:[OSSchedLock] Called from ISR!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+	if(g_OSSchedLockNestCnt == 0xFF)
+	{
+		printf("ERROR:[OSSchedLock] Nested too deep!\r\n");
+	}
+	else
+	{
+		g_OSSchedLockNestCnt++;
 	}
 	OS_EXIT_CRITICAL();
 }
 
+/*********************************************************************************************************
+* ƣOSSchedUnlock
+* ܣ
+* void
+* void
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺
+*           (1) ʱڼе ֻһ PendSV
+*           (2) же
+*********************************************************************************************************/
+void OSSchedUnlock(void)
+{
+	u8 sched = 0;
+
+	if(OS_InISR())
+	{
+		printf("ERROR:[OSSchedUnlock] Called from ISR!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+	if(g_OSSchedLockNestCnt == 0)
+	{
+		printf("ERROR:[OSSchedUnlock] Scheduler is not locked!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	g_OSSchedLockNestCnt--;
+	if(g_OSSchedLockNestCnt == 0 && g_OSSchedFlag == 1)
+	{
+		g_OSSchedFlag = 0;
+		sched = 1;
+	}
+	OS_EXIT_CRITICAL();
+
+	if(sched)
+	{
+		OS_PortPendSVTrigger();
+	}
+}
+
 /*********************************************************************************************************
 * ƣOSDelay
 * ܣʱ
@@ -434,7 +464,9 @@ void OSIntExit(void)
 * void
 *   ֵvoid
 * ڣ20260131
-* ע    ⣺же
+* ע    ⣺
+*           (1) же ڵڼ
+*           (2) time Ϊ0ʱʱб ֻѵǰƵͬȼбĩβµ
 *********************************************************************************************************/
 void OSDelay(u32 time)
 {
@@ -443,11 +475,57 @@ void OSDelay(u32 time)
 		printf("Warning: Try to Delay IdleTask!\r\n");
 		return;
 	}
+	if(OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSDelay] Scheduler is locked!\r\n");
+		return;
+	}
 	
-  __set_BASEPRI(1);            //ж
+	if(time == 0)	//ʱ óCPUͬȼ 񱣳־̬
+	{
+		OS_ENTER_CRITICAL();
+		OS_RdyTaskRemove(g_pCurrentTask);
+		OS_RdyTaskAdd(g_pCurrentTask);
+		OS_EXIT_CRITICAL();
+		OS_PortPendSVTrigger();
+		return;
+	}
+	
+	OS_ENTER_CRITICAL();
 	g_pCurrentTask->tick = time;
+	g_pCurrentTask->state = OS_TASK_DELAY;
 	OS_RdyTaskRemove(g_pCurrentTask);		//Ƴб
 	OS_TickTaskInsert(g_pCurrentTask, time);	//ʱб
-  __set_BASEPRI(0);            //ж
-  PENDSV_TRIGGER;              //л
+	OS_EXIT_CRITICAL();
+	OS_PortPendSVTrigger();	//л
+}
+
+/*********************************************************************************************************
+* ƣOSGetWakeupCnt
+* ܣȡSysTickжۼƴ
+* void
+* void
+*   ֵĽжϴ
+* ڣ20260205
+* ע    ⣺
+*           (1) 1sȡΪÿ뻽ѴڽԼΪ1000
+*           (2) tickless ģʽڼ䲻жϣ֤Ѵ½
+*********************************************************************************************************/
+u32 OSGetWakeupCnt(void)
+{
+	return s_OSWakeupCnt;
+}
+
+/*********************************************************************************************************
+* ƣOS_IdleTaskGet
+* ܣȡ
+* void
+* void
+*   ֵ
+* ڣ20260211
+* ע    ⣺û CPUͳԿʱΪ׼
+*********************************************************************************************************/
+OS_TASK_HANDLE* OS_IdleTaskGet(void)
+{
+	return &s_structIdleHandle;
 }
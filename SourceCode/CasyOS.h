@@ -6,7 +6,7 @@
 * ڣ20260131 
 *     ݣ
 *           (1) ں˺ݽṹ壺TCBʱ
-*           (2) ں˶壺źϢС¼־
+*           (2) ں˶壺źϢС¼־顢ʱ
 *           (3) ڴӿڣOSMalloc/OSFreeɲü
 *           (4) ں API ȡעᡢʱͬ
 *
@@ -34,6 +34,19 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+//Ҫֲṩʱ
+#if OS_CFG_TASK_PROFILE_EN != 0 || OS_CFG_TRACE_EN != 0 || OS_CFG_DEFER_EN != 0
+#define OS_PORT_TIMESTAMP_EN	1
+#else
+#define OS_PORT_TIMESTAMP_EN	0
+#endif
+
+//Ҫ¼ֻȼ̳ʱȼ ɾʱܾɾowner
+#if OS_CFG_MUTEX_EN != 0 && (OS_CFG_MUTEX_PI_EN != 0 || OS_CFG_TASK_DEL_EN != 0)
+#define OS_MUTEX_HELD_EN		1
+#else
+#define OS_MUTEX_HELD_EN		0
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ
@@ -44,6 +57,7 @@ typedef struct OS_RDY_LIST OS_RDY_LIST;
 typedef struct OS_TICK_LIST OS_TICK_LIST;
 typedef struct OS_PEND_LIST OS_PEND_LIST;
 typedef struct OS_Q OS_Q;
+typedef struct OS_TMR OS_TMR;
 
 /*--------------------------------------------------------------------------------------------------------
                                                ں˶ͨ
@@ -58,7 +72,11 @@ typedef enum OS_OBJ_TYPE
 	OS_OBJ_TYPE_SEM,		//ź
 	OS_OBJ_TYPE_MUTEX,	//ź
 	OS_OBJ_TYPE_Q,			//Ϣ
-	OS_OBJ_TYPE_FLAG		//¼־
+	OS_OBJ_TYPE_FLAG,		//¼־
+	OS_OBJ_TYPE_TMR,		//ʱ
+	OS_OBJ_TYPE_DEFER,	//жӺ
+	OS_OBJ_TYPE_NOTIFY,	//֪ͨ
+	OS_OBJ_TYPE_MEM_PART	//̶ڴ
 }OS_OBJ_TYPE;
 
 /*
@@ -74,6 +92,23 @@ typedef struct OS_PEND_LIST
 	OS_TASK_HANDLE* tailPtr;	//βָ
 }OS_PEND_LIST;
 
+/*
+ * OS_PEND_STAT
+ * ܣȴĽxxxPendTimeout ķֵ
+ * ˵
+ *   OS_PEND_OK      : Դ/Ϣ/־
+ *   OS_PEND_TIMEOUT : ʱʱδȵѴӶбƳ
+ *   OS_PEND_ERR     : δȴ
+ */
+typedef enum OS_PEND_STAT
+{
+	OS_PEND_OK,
+	OS_PEND_TIMEOUT,
+	OS_PEND_ERR
+}OS_PEND_STAT;
+
+#define OS_WAIT_FOREVER	0	//ʱȡ0ʾõȴ
+
 /*--------------------------------------------------------------------------------------------------------
                                                ڴ
 --------------------------------------------------------------------------------------------------------*/
@@ -87,13 +122,29 @@ typedef struct OS_PEND_LIST
  *      bit[31] = 1 ռãbit[31] = 0 
  *      bit[30:0] ʾÿĴСλֽڣ
  *   memNextNode:
- *      ָһڴ
+ *      ָڵĺһڴ(һΪNULL)
+ *   memPrevNode:
+ *      ָڵǰһڴ(һΪNULL) ͷʱֱǰϲ Ҫͷ
+ *   TLSF(OS_CFG_MEM_TLSF_EN) ʱ:
+ *      memPrevPhys ָڵǰһ(һΪNULL) ͷʱֱǰϲ
+ *      memNextFree/memPrevFree Ϊָ ֻڿпЧ ռÿص ͷ
  */
+#if OS_CFG_MEM_TLSF_EN == 0
 typedef struct OS_MEM_NODE
 {
 	u32 								memUsedSize;	//ڴռôС
-	struct OS_MEM_NODE* memNextNode;	//ڴͷ(¼ռϢ)
+	struct OS_MEM_NODE* memNextNode;	//ڵĺһ
+	struct OS_MEM_NODE* memPrevNode;	//ڵǰһ
+}OS_MEM_NODE, *OS_MEM_LIST;
+#else
+typedef struct OS_MEM_NODE
+{
+	struct OS_MEM_NODE* memPrevPhys;	//ڵǰһ
+	u32 								memUsedSize;	//ռñ־С
+	struct OS_MEM_NODE* memNextFree;	//(п)
+	struct OS_MEM_NODE* memPrevFree;	//ǰ(п)
 }OS_MEM_NODE, *OS_MEM_LIST;
+#endif
 
 /*
  * ڴģ״̬ö
@@ -104,29 +155,138 @@ typedef enum OS_MEM_STAT
 	OS_MEM_READY				//ڴģѾ
 }OS_MEM_STAT;
 
+/*
+ * ڴԣɰλϣ
+ */
+#define OS_MEM_ATTR_FAST		0x01	//ڴ(ڲSRAM/CCMȴ洢) СĬȷ
+#define OS_MEM_ATTR_DMA			0x02	//DMA Է(Cortex-M4  CCM )
+
+/*
+ * OS_MEM_REGION
+ * ܣһڴÿԼĿ
+ * Ա˵
+ *   name      : 
+ *   attr      : ԣOS_MEM_ATTR_xxx ϣ
+ *   memoryBase: һĿͷַѶ TLSF ֮ǰ С
+ *   memoryEnd : ַֹѶ룩
+ *   memoryList: ڴͷϵĵһ飩
+ *   memoryTlsf: TLSF пOS_CFG_MEM_TLSF_EN
+ *   nextRegion: һע򣨰ע˳ һΪڲڴأ
+ *   freeBytes : ֽСȥռÿ  + ͷ /ͷʱά
+ *   freeMin   : freeBytes ʷСֵˮλ
+ *   fragNum   : п
+ *   allocCnt/freeCnt/failCnt: ɹ/ɹͷ/OSMallocFrom ڸʧܵĴ
+ *   largestFree : ״ʱĳִпĴСϲĿʱ ÿ鱻ʱΪʣĴС
+ *   freeClassMap/freeClassCnt: ״ʱ 2 ݻֵĿпСȼλͼȼ
+ */
+typedef struct OS_MEM_REGION
+{
+	u8*										name;							//
+	u32										attr;							//
+	u8*										memoryBase;				//ʼַ
+	u8*										memoryEnd;				//ַֹ
+	OS_MEM_LIST						memoryList;				//ڴ
+#if OS_CFG_MEM_TLSF_EN != 0
+	struct OS_MEM_TLSF*		memoryTlsf;				//TLSF п
+#endif
+	struct OS_MEM_REGION*	nextRegion;				//һ
+	u32										freeBytes;				//ֽ
+	u32										freeMin;					//ֽˮλ
+	u32										fragNum;					//п
+	u32										allocCnt;					//ɹ
+	u32										freeCnt;					//ɹͷŴ
+	u32										failCnt;					//ʧܴ
+#if OS_CFG_MEM_TLSF_EN == 0
+	u32										largestFree;			//ĳпĴС(п½)
+	u32										freeClassMap;			//пСȼλͼ bit[k]: дС[2^k, 2^(k+1))Ŀп
+	u32										freeClassCnt[32];	//СȼĿп
+#endif
+}OS_MEM_REGION;
+
+/*
+ * OS_MEM_STATS
+ * ܣڴʹƬͳƣOSMemStats / OSMemRegionStats 
+ * ˵ֽͳƿھ OSMemoryPerused ͬռÿĿͷã
+ */
+typedef struct OS_MEM_STATS
+{
+	u32 totalBytes;		//ֽ
+	u32 freeBytes;		//ֽ
+	u32 freeMin;			//ֽʷСֵ(ˮλ)
+	u32 largestFree;	//пС½(ֵһܷɹ)
+	u32 fragNum;			//п(Ƭ)
+	u32 allocCnt;			//ɹ
+	u32 freeCnt;			//ɹͷŴ
+	u32 failCnt;			//ʧܴ
+}OS_MEM_STATS;
+
 /*
  * OS_MEM_DEV
  * ܣڴ
  * Ա˵
  *   init      : ʼڴģ
  *   perused   : ȡڴʹʣ0~1000  0~100ȡʵ֣
- *   memoryBase: ڴʼַ
- *   memoryEnd : ڴַֹ
- *   memoryList: ڴͷ
+ *   regionList: עڴһΪڲڴ s_OSMemoryPool
  *   memoryRdy : ģ״̬
+ *   freeBytes/freeMin: Ŀֽ֮ͼʷСֵ
+ *   failCnt   : OSMalloc/OSMallocAttr/OSMallocFrom ʧܴܵ
  */
 typedef struct OS_MEM_DEV
 {
   void					(*init)(void);		//ʼ
   u16						(*perused)(void);	//ڴʹ
-  u8*						memoryBase;				//ڴʼַ
-	u8*						memoryEnd;				//ڴַֹ
-  OS_MEM_LIST   memoryList;				//ڴ
+  OS_MEM_REGION* regionList;			//ڴ
   OS_MEM_STAT   memoryRdy;				//ڴǷ
+	u32						freeBytes;				//ֽ
+	u32						freeMin;					//ֽˮλ
+	u32						failCnt;					//ʧܴ
 }OS_MEM_DEV;
 
 #endif	//OS_CFG_MEM_EN
 
+#if OS_CFG_MEM_PART_EN != 0
+
+/*
+ * OS_MEM_PART
+ * ܣ̶ڴN СͬĿ ûṩ洢
+ * Ա˵
+ *   objType  : Ϊ OS_OBJ_TYPE_MEM_PART
+ *   pendList : Ϊʱȴڴб
+ *   freeList : п鵥 ָڿпĵһ ҪĿͷ
+ *   freeMin  : пʷСֵˮλ
+ *   getCnt/failCnt : ɹȡ / Ϊյ»ȡʧ(ȴʱ)Ĵ
+ */
+typedef struct OS_MEM_PART
+{
+	OS_OBJ_TYPE 	objType;		//
+	OS_PEND_LIST 	pendList;		//б
+	u8						*name;			//
+	u8						*addr;			//洢׵ַ
+	void					*freeList;	//пͷ
+	u32						blockSize;	//С(ֽ)
+	u32						blockNum;		//
+	u32						freeNum;		//ǰп
+	u32						freeMin;		//пʷСֵ
+	u32						getCnt;			//ɹȡ
+	u32						failCnt;		//ȡʧܴ
+}OS_MEM_PART;
+
+/*
+ * OS_MEM_PART_STATS
+ * ܣڴʹͳƣOSMemPartStatsGet 
+ */
+typedef struct OS_MEM_PART_STATS
+{
+	u32	blockSize;	//С(ֽ)
+	u32	blockNum;		//
+	u32	freeNum;		//ǰп
+	u32	usedMax;		//ͬʱռÿֵ
+	u32	getCnt;			//ɹȡ
+	u32	failCnt;		//ȡʧܴ
+}OS_MEM_PART_STATS;
+
+#endif	//OS_CFG_MEM_PART_EN
+
 /*--------------------------------------------------------------------------------------------------------
                                                ź
 --------------------------------------------------------------------------------------------------------*/
@@ -179,6 +339,45 @@ typedef struct OS_Q
 
 #endif	//OS_CFG_Q_EN
 
+/*--------------------------------------------------------------------------------------------------------
+                                               ֪ͨ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TASK_NOTIFY_EN != 0
+
+/*
+ * OS_NOTIFY_ACTION
+ * ܣOSTaskNotify ֵ֪ͨĲ
+ * ˵
+ *   SET_BITS     : value |=           ¼־飩
+ *   INCREMENT    : value++ Բ       ź
+ *   OVERWRITE    : value =  ǳɹ  Ϊ1 ֵֻ
+ *   NO_OVERWRITE : ûδ֪ͨʱ value =  ʧ
+ */
+typedef enum OS_NOTIFY_ACTION
+{
+	OS_NOTIFY_SET_BITS,
+	OS_NOTIFY_INCREMENT,
+	OS_NOTIFY_OVERWRITE,
+	OS_NOTIFY_NO_OVERWRITE
+}OS_NOTIFY_ACTION;
+
+/*
+ * OS_TASK_NOTIFY
+ * ܣ֪ͨǶ TCB  Ҫ
+ * ˵
+ * 	 objType : Ϊ OS_OBJ_TYPE_NOTIFY ȴ֪ͨʱ pendObj ָ򱾽ṹ
+ *   value   : 32λֵ֪ͨ
+ *   pending : 1ʾδ OSTaskNotifyWait ȡߵ֪ͨ
+ */
+typedef struct OS_TASK_NOTIFY
+{
+	OS_OBJ_TYPE    objType;     //
+	u32            value;       //ֵ֪ͨ
+	u8             pending;     //δ֪ͨ
+}OS_TASK_NOTIFY;
+
+#endif	//OS_CFG_TASK_NOTIFY_EN
+
 /*--------------------------------------------------------------------------------------------------------
                                                
 --------------------------------------------------------------------------------------------------------*/
@@ -188,8 +387,9 @@ typedef struct OS_Q
  * OS_MUTEX
  * ܣֵ֧ݹ
  * Ա˵
- *   ownerTcb : ǰл
- *   lockCnt  : ݹͬһظ Pend +1
+ *   ownerTcb    : ǰл
+ *   lockCnt     : ݹͬһظ Pend +1
+ *   heldNextPtr : owner еһOS_MUTEX_HELD_ENڻָȼܾɾowner
  */
 typedef struct OS_MUTEX
 {
@@ -198,6 +398,9 @@ typedef struct OS_MUTEX
 	u8							*name;			//
 	OS_TASK_HANDLE 	*ownerTcb;	//ǰл
 	u32 						lockCnt;		//ݹ
+#if OS_MUTEX_HELD_EN != 0
+	struct OS_MUTEX *heldNextPtr;	//ownerеĻָ
+#endif
 }OS_MUTEX;
 
 #endif	//OS_CFG_MUTEX_EN
@@ -250,9 +453,192 @@ typedef enum OS_FLAG_SET_OPT
 
 #endif	//OS_CFG_FLAG_EN
 
+/*--------------------------------------------------------------------------------------------------------
+                                               ʱ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TMR_EN != 0
+
+/*
+ * ʱͣ
+ * - OS_TMR_OPT_ONE_SHOT : ִһλص COMPLETED ״̬
+ * - OS_TMR_OPT_PERIODIC : ÿ period ִһλص
+ */
+typedef enum OS_TMR_OPT
+{
+	OS_TMR_OPT_ONE_SHOT,
+	OS_TMR_OPT_PERIODIC
+}OS_TMR_OPT;
+
+/*
+ * ʱ״̬
+ * - OS_TMR_STATE_STOPPED   : Ѵֹͣ
+ * - OS_TMR_STATE_RUNNING   : λڶʱеȴ
+ * - OS_TMR_STATE_COMPLETED : ζʱѵ
+ */
+typedef enum OS_TMR_STATE
+{
+	OS_TMR_STATE_STOPPED,
+	OS_TMR_STATE_RUNNING,
+	OS_TMR_STATE_COMPLETED
+}OS_TMR_STATE;
+
+typedef void (*OS_TMR_CALLBACK)(OS_TMR *p_tmr, void *p_arg);	//ʱص ڶʱִ
+
+/*
+ * OS_TMR
+ * ܣʱ
+ * Ա˵
+ *   delay  : ״εڵĽ
+ *   period : ڶʱ
+ *   expire : Եʱ(ϵͳ) ʱ
+ */
+typedef struct OS_TMR
+{
+	OS_OBJ_TYPE					objType;		//
+	u8									*name;			//ʱ
+	OS_TMR_CALLBACK			callback;		//ڻص
+	void								*p_arg;			//ص
+	u32									delay;			//״εڽ
+	u32									period;			//ڽ
+	OS_TMR_OPT					opt;				///
+	OS_TMR_STATE				state;			//ǰ״̬
+	u64									expire;			//Եʱ
+	OS_TMR							*nextPtr;		//ʱ
+	OS_TMR							*prevPtr;		//ʱǰ
+}OS_TMR;
+
+#endif	//OS_CFG_TMR_EN
+
+/*--------------------------------------------------------------------------------------------------------
+                                               ¼׷
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TRACE_EN != 0
+
+#define OS_TRACE_ID_NONE	0xFF	//(ǰ)׷ٱ
+#define OS_TRACE_NAME_LEN	16		//Ƶ󳤶()
+
+/*
+ * OS_TRACE_EVENT
+ * ܣ׷¼ͣOS_TRACE_REC.event
+ * ˵arg ĺ¼
+ *   TASK_SWITCH : obj= taskId= arg=
+ *   TASK_READY  : obj=ȴĶ arg8λ= 8λ=OS_PEND_STAT
+ *   ISR_ENTER/EXIT : arg=仯жǶײ
+ *   xxx_POST    : obj= arg=1ʾֱӽ˵ȴ(FLAG_POST Ϊ OS_FLAG_SET_OPT)
+ *   xxx_PEND    : obj= arg=1ʾҪȴ 0ʾ
+ */
+typedef enum OS_TRACE_EVENT
+{
+	OS_TRACE_NONE,
+	OS_TRACE_TASK_SWITCH,	//л
+	OS_TRACE_TASK_READY,	//ȴ(Postѻʱ)
+	OS_TRACE_ISR_ENTER,		//ж
+	OS_TRACE_ISR_EXIT,		//˳ж
+	OS_TRACE_SEM_POST,
+	OS_TRACE_SEM_PEND,
+	OS_TRACE_Q_POST,
+	OS_TRACE_Q_PEND,
+	OS_TRACE_MUTEX_POST,
+	OS_TRACE_MUTEX_PEND,
+	OS_TRACE_FLAG_POST,
+	OS_TRACE_FLAG_PEND,
+	OS_TRACE_NOTIFY_POST,
+	OS_TRACE_NOTIFY_PEND,
+	OS_TRACE_MEM_PUT,
+	OS_TRACE_MEM_GET,
+	OS_TRACE_EVENT_NUM
+}OS_TRACE_EVENT;
+
+/*
+ * OS_TRACE_REC
+ * ܣһ׷ټ¼12ֽ  ֱӰƵ
+ * Ա˵
+ *   timestamp : OS_PortTimestampGet() ֵ 32λɽ˴
+ *   obj       : /ַĵ32λ ֶ
+ *   taskId    : ¼ʱе(OSRegister)
+ */
+typedef struct OS_TRACE_REC
+{
+	u32	timestamp;	//ʱ
+	u32	obj;				//ַ
+	u8	event;			//¼ OS_TRACE_EVENT
+	u8	taskId;			//ǰ
+	u16	arg;				//¼
+}OS_TRACE_REC;
+
+/*
+ * OS_TRACE_TASK
+ * ܣƵĶӦOSTraceTaskTableGet  ˻ԭ
+ */
+typedef struct OS_TRACE_TASK
+{
+	u8		taskId;											//
+	u8		priority;										//עʱȼ
+	u16		reserved;
+	char	name[OS_TRACE_NAME_LEN];		//(ض)
+}OS_TRACE_TASK;
+
+#endif	//OS_CFG_TRACE_EN
+
+/*--------------------------------------------------------------------------------------------------------
+                                               жӺ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_DEFER_EN != 0
+
+typedef void (*OS_DEFER_FUNC)(void *p_arg, u32 data);	//Ӻ ڷִ
+
+/*
+ * OS_DEFER_STATS
+ * ܣӺͳƣOSDeferStatsGet 
+ * Ա˵
+ *   depthMax     : ͬʱȴ(ˮλ)
+ *   overflowCnt  : µǼʧܵĴ
+ *   latencyMaxUs : жϵǼǵʼִеӳ(us)
+ */
+typedef struct OS_DEFER_STATS
+{
+	u32	postCnt;				//Ǽǳɹ
+	u32	runCnt;					//ִд
+	u32	overflowCnt;		//Ǽʧܴ
+	u32	depthMax;				//
+	u32	latencyMaxUs;		//ӳ(us)
+	u32	latencyAvgUs;		//ƽӳ(us)
+}OS_DEFER_STATS;
+
+#endif	//OS_CFG_DEFER_EN
+
+/*--------------------------------------------------------------------------------------------------------
+                                               ֲ
+--------------------------------------------------------------------------------------------------------*/
+/*
+ * ֲӿڣоƬںصĲ֣ÿֲļʵһ
+ * - os_port_cm.c    : Cortex-M3/M4PendSV/SVC/SysTick
+ * - os_port_posix.c : Linux ˷棨ucontext + ʱźţ Linux_HostDemo
+ */
+
+//OSڲ Щһں˵ ûֱӵ
+void OS_PortStkInit(OS_TASK_HANDLE* p_tcb);	//ʼջ֡ stackTop
+void OS_PortStartFirstTask(void);						//ϵͳĲһ()
+void OS_PortPendSVTrigger(void);						//һл
+void OS_ENTER_CRITICAL(void);								//ٽ(Ƕ)
+void OS_EXIT_CRITICAL(void);								//˳ٽ(˳ʱָж״̬)
+void SVC_Handler(void);       							//SVCжϷ(Cortex-M)
+void PendSV_Handler(void);    							//PendSVжϷ(Cortex-M)
+#if OS_CFG_TICKLESS_EN != 0
+u32  OS_PortTicklessSleep(u32 ticks);				//ͣڽticks 貹ǵ
+#endif
+#if OS_PORT_TIMESTAMP_EN != 0
+u32  OS_PortTimestampGet(void);							//ȡ32λʱ(Cortex-MΪDWT CYCCNT)
+u32  OS_PortTimestampFreq(void);						//ʱƵ(Hz)
+#endif
+
 /*--------------------------------------------------------------------------------------------------------
                                                
 --------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TASK_STK_CHK_EN != 0
+#define OS_TASK_STK_PATTERN 0xCA5ECA5EU	//ջֵ ջΪֵĲΪδʹ
+#endif
+
 /*
  * OS_TASK_STAT
  * ܣ״̬ö
@@ -319,19 +705,28 @@ typedef enum OS_TASK_ID_TYPE
  * ܣƿ飨Task Control Block
  * ؼֶ˵
  *   stackTop/stackBase/stackSize : ջϢstackTop ڽṹ׵ַ
- *   priority                    : ȼֵԽСȼԽߣ
+ *   priority                    : ǰȼֵԽСȼԽߣܱȼ̳ʱ
+ *   basePriority                : עʱĻȼ
  *   tick                        : ʱ OSDelay / TickList
  *   state                       : ǰ״̬
  *   pendObj                     : ǰȴĶָ루NULLʾδ
+ *   pendStat                    : һȴĽɹ/ʱ
  *   nextPtr                     : ȫָ
  *   rdyNextPtr/rdyPrevPtr       : ˫ָ
  *   tickNextPtr/tickPrevPtr     : ʱ˫ָ
  *   pendNextPtr/pendPrevPtr     : ˫ָ
  *
  * ɲüֶΣ
+ *   timeQuanta: ʱƬȼʣOS_CFG_SCHED_RR_EN
+ *   suspended :  OSTaskSuspend OS_CFG_TASK_SUSPEND_EN
+ *   mutexHeld : ǰеĻOS_MUTEX_HELD_EN
  *   sem       : ڽźOS_CFG_SEM_EN
  *   msgQueue  : ڽϢУOS_CFG_Q_EN
+ *   notify    : ֵ֪ͨOS_CFG_TASK_NOTIFY_EN
+ *   memPartBlk: ȴڴʱ OSMemPartPut ֱӽڴ飨OS_CFG_MEM_PART_EN
  *   flagsPend : ¼־ȴOS_CFG_FLAG_EN
+ *   runTime   : ۼʱ뱻ȴOS_CFG_TASK_PROFILE_EN
+ *   traceId   : ׷ټ¼ʹõţOS_CFG_TRACE_EN
  */
 typedef struct OS_TASK_HANDLE
 {
@@ -341,9 +736,11 @@ typedef struct OS_TASK_HANDLE
   void* 						func;      				//ڣΪ void (*)(void) ͵ĺָ
 	char* 						taskName;	 				//
   u32   						priority;  				//ȼ0Ϊȼ
-  u64   						tick;      				//ʱλms
+  u32   						basePriority;			//ȼ(δȼ̳ʱȼ)
+  u64   						tick;      				//ʱλms ʱģʽΪʱ(ϵͳ)
 	OS_TASK_STAT 			state;						//ǰ״̬
 	void* 						pendObj;					//ǰȴĶ(NULLʾûйȴ)
+	OS_PEND_STAT 			pendStat;					//һȴĽ
 	OS_TASK_HANDLE* 	nextPtr;					//ȫָ
 	OS_TASK_HANDLE* 	rdyNextPtr;				//ָ
 	OS_TASK_HANDLE* 	rdyPrevPtr;				//бǰָ
@@ -351,6 +748,16 @@ typedef struct OS_TASK_HANDLE
 	OS_TASK_HANDLE* 	tickPrevPtr;			//ʱбǰָ
 	OS_TASK_HANDLE* 	pendNextPtr;			//бָ
 	OS_TASK_HANDLE* 	pendPrevPtr;			//бǰָ
+#if OS_CFG_SCHED_RR_EN != 0
+	u32 							timeQuanta;				//ʱƬ(tick)
+	u32 							timeQuantaCtr;		//ǰʱƬʣtick
+#endif
+#if OS_CFG_TASK_SUSPEND_EN != 0
+	u8 								suspended;				//1= ȴбʱȴת OS_TASK_STOP
+#endif
+#if OS_MUTEX_HELD_EN != 0
+	OS_MUTEX* 				mutexHeldPtr;			//ǰеĻͷ
+#endif
 #if OS_CFG_SEM_EN != 0
 	OS_SEM 						sem;							//ڽź
 #endif
@@ -358,12 +765,46 @@ typedef struct OS_TASK_HANDLE
 	OS_Q 							msgQueue;					//ڽϢ
 	u32 							msgTemp;					//ǰյϢ
 #endif
+#if OS_CFG_TASK_NOTIFY_EN != 0
+	OS_TASK_NOTIFY		notify;						//֪ͨ
+#endif
+#if OS_CFG_MEM_PART_EN != 0
+	void* 						memPartBlk;				//ȴڴʱյڴ
+#endif
 #if OS_CFG_FLAG_EN != 0
 	u32 							flagsMaskPendOn;	//ȴļλ־λ(λ)
 	OS_FLAG_PEDN_OPT 	flagsPendOpt;			//ȴALL/ANY SET/CLR
 #endif
+#if OS_CFG_TASK_PROFILE_EN != 0
+	u64 							runTime;					//ۼʱ(ʱ)
+	u64 							runTimeSnap;			//ϴοʱ runTime ڼͳƴڵռ
+	u32 							switchCnt;				//леĴ
+#endif
+#if OS_CFG_TRACE_EN != 0
+	u8 								traceId;					//׷(עʱ ɾʱ黹)
+#endif
 }OS_TASK_HANDLE;
 
+#if OS_CFG_TASK_PROFILE_EN != 0
+/*
+ * OS_TASK_RUNINFO
+ * ܣͳƿգOSTaskRunInfoGet 
+ * Ա˵
+ *   runTimeUs : ۼʱ(us) жִʱ뱻ϵ
+ *   usage     : ϴοյͳƴռCPUǧֱ
+ */
+typedef struct OS_TASK_RUNINFO
+{
+	OS_TASK_HANDLE*		p_tcb;						//
+	char*							name;							//
+	u32								priority;					//ǰȼ
+	OS_TASK_STAT			state;						//ǰ״̬
+	u64								runTimeUs;				//ۼʱ(us)
+	u32								switchCnt;				//ȴ
+	u16								usage;						//CPUռ(ǧֱ)
+}OS_TASK_RUNINFO;
+#endif
+
 /*********************************************************************************************************
 *                                              API
 *********************************************************************************************************/
@@ -373,12 +814,10 @@ typedef struct OS_TASK_HANDLE
 //OSڲ Щһں˵ ûֱӵ
 void OS_Sched(void); 							//(ͨPendSV)
 void OS_UpdateCurrentTask(void);	//µǰӦ(ѡȼ)
+u8   OS_SchedNeeded(void);				//ȼǷǵǰ
 void SysTick_Handler(void);   		//SysTickжϷ
-void SVC_Handler(void);       		//SVCжϷ
-void PendSV_Handler(void);    		//PendSVжϷ
-void OS_ENTER_CRITICAL(void);			//ٽ
-void OS_EXIT_CRITICAL(void);			//˳ٽ
 u8	 OS_InISR(void);
+u8	 OS_SchedIsLocked(void);				//Ƿ(ڼ䲻)
 
 //û ûԵ
 void InitCasyOS(void);
@@ -395,6 +834,10 @@ void OSStart(void);     					//ϵͳ
 void OSDelay(u32 time); 					//ʱ
 void OSIntEnter(void);						//֪ͨCasyOSжϻжǶ
 void OSIntExit(void);							//֪ͨCasyOS˳ж
+void OSSchedLock(void);						//(Ƕ) жϱֿ л
+void OSSchedUnlock(void);					// ʱһε
+u32  OSGetWakeupCnt(void);				//ȡϵͳжۼƴ(ͳÿ뻽Ѵ)
+OS_TASK_HANDLE* OS_IdleTaskGet(void);	//ȡ(ڲ)
 
 /*--------------------------------------------------------------------------------------------------------
                                                
@@ -409,20 +852,50 @@ void OSIntExit(void);							//֪ͨCasyOS
 //û
 void OSInitTaskSched(void);																	//ʼȹģ
 OS_TASK_HANDLE* OSTaskFind(OS_TASK_ID_TYPE opt, void *id);	//ղͬϢ
+u64  OSTimeGet(void);																				//ȡϵͳļ
+#if OS_CFG_SCHED_RR_EN != 0
+void OSYield(void);																					//óCPUͬȼһ
+void OSTaskSetTimeQuanta(OS_TASK_HANDLE *p_tcb, u32 quanta);	//ʱƬ(0ʾʹĬֵ)
+#endif
+#if OS_CFG_TASK_PROFILE_EN != 0
+u32  OSTaskRunInfoGet(OS_TASK_RUNINFO *p_info, u32 maxNum, u16 *p_load);	//ͳ  p_loadCPU(ǧֱ)
+#endif
+#if OS_CFG_TASK_STK_CHK_EN != 0
+u32  OSTaskStackFree(OS_TASK_HANDLE *p_tcb);								//ջʷСʣ(λu32)
+u32  OSTaskStackUsed(OS_TASK_HANDLE *p_tcb);								//ջʷʹ(λu32)
+void OSTaskStackReport(void);																//ӡջʹ
+#endif
+void OSTaskChangePrio(OS_TASK_HANDLE *p_tcb, u32 prio);			//ʱ޸ȼ(NULLʾǰ)
+#if OS_CFG_TASK_SUSPEND_EN != 0
+void OSTaskSuspend(OS_TASK_HANDLE *p_tcb);									//(NULLʾǰ)
+void OSTaskResume(OS_TASK_HANDLE *p_tcb);										//ָ
+#endif
+#if OS_CFG_TASK_DEL_EN != 0
+void OSTaskDelete(OS_TASK_HANDLE *p_tcb);										//ɾ(NULLʾǰ) ֮ OSRegister ע
+#endif
 
 //OSڲ
 void OS_TaskListInit(void);                          				//ʼȫ
 void OS_TaskListAdd(OS_TASK_HANDLE *p_tcb);          				//ȫ
 void OS_TaskListRemove(OS_TASK_HANDLE *p_tcb);       				//ȫɾ
+void OS_TaskReturn(void);																		//غĳ(ֲ㹹ʼջ֡ʱʹ)
 
 void OS_RdyListInit(void);                           				//ʼ
 void OS_RdyTaskAdd(OS_TASK_HANDLE *p_tcb);           				//
 void OS_RdyTaskRemove(OS_TASK_HANDLE *p_tcb);        				//Ƴ
+void OS_TaskPrioSet(OS_TASK_HANDLE *p_tcb, u32 prio);				//޸ǰȼͬʱеλã
+#if OS_CFG_SCHED_RR_EN != 0
+void OS_RdyListRotate(u32 prio);                     				//ͷתĩβ
+void OS_SchedRoundRobin(void);                       				//ʱƬSysTickеã
+#endif
 
 void OS_TickListInit(void);                          				//ʼʱ
 void OS_TickTaskInsert(OS_TASK_HANDLE *p_tcb, u64 time); 		//ʱtimeΪʱtick
 void OS_TickTaskRemove(OS_TASK_HANDLE *p_tcb);       				//Ƴʱ
 void OS_TickUpdate(void);                            				//δ£ʱ
+void OS_TickUpdateBatch(u32 ticks);                  				//һβǶģticklessѺʹã
+u64  OS_TickGetNextWakeup(void);                     				//ʱڵtick0ʾʱ
+u64  OS_TickCntGet(void);                            				//ȡϵͳļٽ ںٽʹã
 
 void OS_BitMapInit(void);                            				//ʼȼλͼ
 void OS_BitMapSet(u32 prio);                         				//λĳȼ
@@ -434,6 +907,9 @@ void OS_PendListInsert(OS_PEND_LIST *p_pend_list, OS_TASK_HANDLE *p_tcb); //
 void OS_PendListRemove(OS_PEND_LIST *p_pend_list, OS_TASK_HANDLE *p_tcb); //Ƴָ
 void OS_PendListPopAlltoRdyList(OS_PEND_LIST *p_pend_list);      					//ȫת
 OS_TASK_HANDLE* OS_PendListGetHighest(OS_PEND_LIST *p_pend_list);					//ȡȼȴ
+OS_PEND_LIST* OS_ObjPendListGet(void *p_obj);																//ȡں˶Ĺ(û򷵻NULL)
+void OS_PendTaskBlock(OS_PEND_LIST *p_pend_list, void *p_obj, u32 timeout);	//ǰȴ(ɴʱ)
+void OS_PendTaskReady(OS_TASK_HANDLE *p_tcb, OS_PEND_STAT stat);						//ȴ(Ƴ)
 
 
 /*--------------------------------------------------------------------------------------------------------
@@ -446,9 +922,36 @@ void  OSInitMemory(void);     	//
 u16   OSMemoryPerused(void);  	//ڴʹ(/ڲ) 
 void* OSMalloc(u32 size); 			//ڴ(λֽ)
 void  OSFree(void* ptr);  			//ڴͷ
+u8    OSMemRegionAdd(OS_MEM_REGION *p_region, u8 *p_name, void *p_addr, u32 size, u32 attr);	//עڴ
+u16   OSMemRegionPerused(OS_MEM_REGION *p_region);	//ָڴʹ
+void* OSMallocFrom(OS_MEM_REGION *p_region, u32 size);	//ָ
+void* OSMallocAttr(u32 size, u32 attr);							//ӾָԵ
+void  OSMemStats(OS_MEM_STATS *p_stats);								//ѵʹƬͳ
+void  OSMemRegionStats(OS_MEM_REGION *p_region, OS_MEM_STATS *p_stats);	//ָʹƬͳ
+#if OS_CFG_MEM_CHECK_EN != 0
+u8    OSMemCheck(void);					//˳пͷ()
+#endif
 
 #endif	//OS_CFG_MEM_EN
 
+#if OS_CFG_MEM_PART_EN != 0
+/*
+ * ڴӿ˵
+ * OSMemPartCreate     : ûṩĴ洢Ϊ blockNum  blockSize ֽڵĿ
+ * OSMemPartGet        : ȡһп ΪʱNULLжоɵã
+ * OSMemPartGetTimeout : ȡһп Ϊʱȴֻеã
+ * OSMemPartPut        : 黹ڴ ڵȴʱֱӽȼߵĵȴߣжоɵã
+ */
+
+//û
+u8    OSMemPartCreate(OS_MEM_PART *p_part, u8 *p_name, void *p_addr, u32 blockNum, u32 blockSize);	//ڴ
+void* OSMemPartGet(OS_MEM_PART *p_part);														//ȡڴ(ȴ)
+void* OSMemPartGetTimeout(OS_MEM_PART *p_part, u32 timeout);				//ȡڴ(Ϊʱȴ) ʱNULL
+void  OSMemPartPut(OS_MEM_PART *p_part, void *p_blk);								//黹ڴ
+void  OSMemPartStatsGet(OS_MEM_PART *p_part, OS_MEM_PART_STATS *p_stats);	//ȡʹͳ
+
+#endif	//OS_CFG_MEM_PART_EN
+
 /*--------------------------------------------------------------------------------------------------------
                                                ڽź
 --------------------------------------------------------------------------------------------------------*/
@@ -457,7 +960,7 @@ void  OSFree(void* ptr);  			//
  * źӿ˵
  * OS_SemInit  : ʼź/չУ
  * OSSemPost   : ͷź+1Ҫʱѹ
- * OSSemPend   : ȴź>0ֱӻȡ
+ * OSSemPend   : ȴź>0ֱӻȡOSSemPendTimeout óʱ
  */
 
 //OSڲ
@@ -465,6 +968,7 @@ void OS_SemInit(OS_SEM *p_sem, u32 countMax);	//
 //û
 void OSSemPost(OS_SEM *p_sem);								//ͷ1ź
 void OSSemPend(OS_SEM *p_sem);								//ȴ1ź
+OS_PEND_STAT OSSemPendTimeout(OS_SEM *p_sem, u32 timeout);	//ʱȴ1ź
 
 #endif	//OS_CFG_SEM_EN
 
@@ -476,7 +980,7 @@ void OSSemPend(OS_SEM *p_sem);								//
  * Ϣнӿ˵ڽУ
  * OS_QInit     : ΪĳʼϢУ̬뻺
  * OSQPost      : ĳзһ 4ֽϢ
- * OSQPend      : ǰȴϢ
+ * OSQPend      : ǰȴϢOSQPendTimeout óʱ
  * OSQFlush     : ն
  * OSQGetCount  : ȡеǰϢ
  * OSQIsEmpty   : ǷΪ
@@ -485,10 +989,12 @@ void OSSemPend(OS_SEM *p_sem);								//
 
 //OSڲ
 void OS_QInit(OS_TASK_HANDLE* p_tcb, u32 countMax);	//ڲϢ
+void OS_QFree(OS_TASK_HANDLE* p_tcb);								//ͷϢл(ɾʱ)
 
 //û
 void OSQPost(OS_TASK_HANDLE* p_tcb, u32 msg);				//4ֽڷϢĳ
 void OSQPend(u32 *p_msg);														//ȴϢϢ
+OS_PEND_STAT OSQPendTimeout(u32 *p_msg, u32 timeout);	//ʱȴϢ
 void OSQFlush(OS_TASK_HANDLE* p_tcb);								//ϢеϢ
 u32  OSQGetCount(OS_TASK_HANDLE* p_tcb);						//ȡϢϢ
 u8 	 OSQIsEmpty(OS_TASK_HANDLE* p_tcb);							//жϢǷ
@@ -496,6 +1002,25 @@ u8 	 OSQIsFull(OS_TASK_HANDLE* p_tcb);							//
 
 #endif //OS_CFG_Q_EN
 
+/*--------------------------------------------------------------------------------------------------------
+                                               ֪ͨ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TASK_NOTIFY_EN != 0
+/*
+ * ֪ͨӿ˵
+ * OSTaskNotify     :  OS_NOTIFY_ACTION ޸Ŀֵ֪ͨ Ŀڵȴʱֱӻ
+ * OSTaskNotifyWait : ǰȴ֪ͨ ȡֵ֪ͨ
+ */
+
+//OSڲ
+void OS_TaskNotifyInit(OS_TASK_HANDLE* p_tcb);			//ʼ֪ͨ(OSRegister)
+
+//û
+u8   OSTaskNotify(OS_TASK_HANDLE* p_tcb, u32 value, OS_NOTIFY_ACTION action);	//֪ͨ 0ʾNO_OVERWRITEʧ
+OS_PEND_STAT OSTaskNotifyWait(u32 clrOnEntry, u32 clrOnExit, u32 *p_value, u32 timeout);	//ȴ֪ͨ
+
+#endif //OS_CFG_TASK_NOTIFY_EN
+
 /*--------------------------------------------------------------------------------------------------------
                                                
 --------------------------------------------------------------------------------------------------------*/
@@ -504,12 +1029,18 @@ u8 	 OSQIsFull(OS_TASK_HANDLE* p_tcb);							//
  * ӿ˵
  * OSMutexCreate : ʼ/owner/lockCnt
  * OSMutexPost   : ͷŻݹͷŲѵȴ
- * OSMutexPend   : ȡռȴ
+ * OSMutexPend   : ȡռȴOSMutexPendTimeout óʱ
  */
 
 void OSMutexCreate(OS_MUTEX *p_mutex, u8* p_name);	//
 void OSMutexPost(OS_MUTEX *p_mutex);								//ͷŻ
 void OSMutexPend(OS_MUTEX *p_mutex);								//ȴ
+OS_PEND_STAT OSMutexPendTimeout(OS_MUTEX *p_mutex, u32 timeout);	//ʱȴ
+#if OS_CFG_MUTEX_PI_EN != 0
+u32  OS_MutexPrioCalc(OS_TASK_HANDLE *p_tcb);				//ȼֻߵȴȼеĽϸ(ڲ)
+void OS_MutexPrioRestore(OS_MUTEX *p_mutex);				//ȴ뿪س¼ownerȼ(ڲ)
+void OS_MutexPendPrioChange(OS_MUTEX *p_mutex, u32 prioOld, u32 prioNew);	//ȴȼ޸ĺownerȼ(ڲ)
+#endif
 
 #endif //OS_CFG_MUTEX_EN
 
@@ -521,13 +1052,89 @@ void OSMutexPend(OS_MUTEX *p_mutex);								//
  * ¼־ӿ˵
  * OSFlagCreate : ־鲢óʼ flags
  * OSFlagPost   : λ/ĳЩ־λǷҪѵȴ
- * OSFlagPend   : ȴĳЩ־λ
+ * OSFlagPend   : ȴĳЩ־λOSFlagPendTimeout óʱ
  * ע: ʼı־λ
  */
 void OSFlagCreate(OS_FLAG *p_flag, u8 *p_name, u32 init_flags);		//¼־
 void OSFlagPost(OS_FLAG *p_flag, u32 mask, OS_FLAG_SET_OPT opt);	//ͷű־λ
 void OSFlagPend(OS_FLAG *p_flag, u32 mask, OS_FLAG_PEDN_OPT opt);	//ȴı־λ
+OS_PEND_STAT OSFlagPendTimeout(OS_FLAG *p_flag, u32 mask, OS_FLAG_PEDN_OPT opt, u32 timeout);	//ʱȴ־λ
 
 #endif
 
+/*--------------------------------------------------------------------------------------------------------
+                                               ʱ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TMR_EN != 0
+/*
+ * ʱӿ˵
+ * OSTmrCreate   : ʱ/ڣص
+ * OSTmrStart    : ʱ򲻱䣩
+ * OSTmrStop     : ֹͣʱ
+ * OSTmrReset    : ӵǰʱ¼ʱ
+ * OSTmrStateGet : ȡʱ״̬
+ * ע: ϽӿжоɵãصڶʱִУ
+ */
+
+//OSڲ
+void OS_TmrInit(void);						//ʼʱע
+void OS_TmrTickUpdate(void);			//Ĵ ʱѷ
+u64  OS_TmrGetNextWakeup(void);		//ʱڵtick0ʾûеĶʱ
+
+//û
+void OSTmrCreate(OS_TMR *p_tmr, u8 *p_name, u32 delay, u32 period, OS_TMR_OPT opt, OS_TMR_CALLBACK callback, void *p_arg);	//ʱ
+void OSTmrStart(OS_TMR *p_tmr);						//ʱ
+void OSTmrStop(OS_TMR *p_tmr);						//ֹͣʱ
+void OSTmrReset(OS_TMR *p_tmr);						//¼ʱ
+OS_TMR_STATE OSTmrStateGet(OS_TMR *p_tmr);	//ȡʱ״̬
+
+#endif //OS_CFG_TMR_EN
+
+/*--------------------------------------------------------------------------------------------------------
+                                               жӺ
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_DEFER_EN != 0
+/*
+ * жӺӿ˵
+ * OSDeferPost     : жеǼһ ȼķ񾡿ִ
+ * OSDeferStatsGet : ȡȡʧӳͳ
+ * ע: ڷִУԵ Post ӿڣ
+ */
+
+//OSڲ
+void OS_DeferInit(void);																	//ʼӺвע
+
+//û
+u8   OSDeferPost(OS_DEFER_FUNC func, void *p_arg, u32 data);	//ǼӺ ɹ1 0
+void OSDeferStatsGet(OS_DEFER_STATS *p_stats);								//ȡͳϢ
+
+#endif //OS_CFG_DEFER_EN
+
+/*--------------------------------------------------------------------------------------------------------
+                                               ¼׷
+--------------------------------------------------------------------------------------------------------*/
+#if OS_CFG_TRACE_EN != 0
+/*
+ * ¼׷ٽӿ˵
+ * OS_TRACE            : ں ر OS_CFG_TRACE_EN ʱչΪ
+ * OSTraceRead         : ȡ¼ɺ̨ڵ ͨ/ļ
+ * OSTraceLostGet      : 򻺳дǵļ¼
+ * OSTraceTaskTableGet : ƵĶӦ
+ */
+#define OS_TRACE(event, p_obj, arg)	OS_TraceRecord((u8)(event), (void*)(p_obj), (u16)(arg))
+
+//OSڲ
+u8   OS_TraceTaskIdAlloc(void);													//Ϊע׷ٱ
+void OS_TraceTaskIdFree(u8 id);														//黹ɾ׷ٱ
+void OS_TraceRecord(u8 event, void *p_obj, u16 arg);		//дһ׷ټ¼(ٽڵ)
+
+//û
+u32  OSTraceRead(OS_TRACE_REC *p_buf, u32 maxNum);			//ȡļ¼ 
+u32  OSTraceLostGet(void);															//ǵļ¼
+u32  OSTraceTaskTableGet(OS_TRACE_TASK *p_tab, u32 maxNum);	// 
+
+#else
+#define OS_TRACE(event, p_obj, arg)
+#endif //OS_CFG_TRACE_EN
+
 #endif	//_CASY_OS_H_
@@ -33,7 +33,9 @@ typedef unsigned long long  u64;
 
 #define TRUE          1
 #define FALSE         0
+#ifndef NULL
 #define NULL          0
+#endif
 #define INVALID_DATA  -100
 
 /*********************************************************************************************************
@@ -0,0 +1,245 @@
+/*********************************************************************************************************
+* ģƣos_defer.c
+* ժ    ҪжӺ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260214
+*     ݣ
+*           (1) жϷֻ OSDeferPost ǼǴʱĹ
+*           (2) ǼǵĴȽȳ˳ȼķִ
+*           (3) ͳƶȸˮλʧԼӵǼǵʼִеӳ
+* ע    ⣺
+*           (1) бΪĵȴ(ڽϢͬ) Ǽʱֱӻѷ񣬲ź
+*           (2) ÷ջûĽӿ(Pend/Delay)
+*           (3) ӳͳʹֲʱ OS_PortTimestampGet
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+#if OS_CFG_DEFER_EN != 0
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#if (OS_CFG_DEFER_Q_SIZE & (OS_CFG_DEFER_Q_SIZE - 1)) != 0
+#error "OS_CFG_DEFER_Q_SIZE must be a power of 2"
+#endif
+
+#define OS_DEFER_Q_MASK	(OS_CFG_DEFER_Q_SIZE - 1)
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+/*
+ * OS_DEFER_ITEM
+ * ܣһִеӺ
+ */
+typedef struct OS_DEFER_ITEM
+{
+	OS_DEFER_FUNC	func;			//
+	void					*p_arg;		//
+	u32						data;			//(յֽ)
+	u32						stamp;		//Ǽʱʱ
+}OS_DEFER_ITEM;
+
+/*
+ * OS_DEFER_Q
+ * ܣӺУĵȴ һԱΪ objType
+ * ˵inCnt/outCnt Ϊм ֮ǰ
+ */
+typedef struct OS_DEFER_Q
+{
+	OS_OBJ_TYPE		objType;													//
+	OS_DEFER_ITEM	arrItem[OS_CFG_DEFER_Q_SIZE];			//λ
+	u32						inCnt;														//ѵǼ
+	u32						outCnt;														//ȡ
+}OS_DEFER_Q;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static OS_DEFER_Q     s_OSDeferQ;																//Ӻ
+static u32            s_arrDeferStack[OS_CFG_DEFER_TASK_STK_SIZE];	//ջ
+static OS_TASK_HANDLE s_structDeferHandle;											//
+static u32            s_OSDeferOverflow;												//ʧ
+static u32            s_OSDeferDepthMax;												//
+static u32            s_OSDeferLatencyMax;											//ӳ(ʱ)
+static u64            s_OSDeferLatencySum;											//ӳۼ(ʱ)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void OS_DeferTask(void);	//Ӻ
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_DeferTask
+* ܣӺ ִжеǼǵĴ
+* void
+* void
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺
+*           (1) ÿֻٽȡһ¼ӳ٣ٽִ
+*           (2) ΪʱԶΪȴпͬһٽɣᶪʧ
+*********************************************************************************************************/
+static void OS_DeferTask(void)
+{
+	OS_DEFER_ITEM item;
+	u32 latency;
+
+	while(1)
+	{
+		OS_ENTER_CRITICAL();
+
+		if(s_OSDeferQ.inCnt == s_OSDeferQ.outCnt)	//Ϊ ȴжϵǼ
+		{
+			OS_PendTaskBlock(NULL, (void*)&s_OSDeferQ, OS_WAIT_FOREVER);
+			OS_EXIT_CRITICAL();
+			OS_Sched();
+			continue;
+		}
+
+		item = s_OSDeferQ.arrItem[s_OSDeferQ.outCnt & OS_DEFER_Q_MASK];
+		s_OSDeferQ.outCnt++;
+
+		latency = OS_PortTimestampGet() - item.stamp;
+		s_OSDeferLatencySum += latency;
+		if(latency > s_OSDeferLatencyMax)
+		{
+			s_OSDeferLatencyMax = latency;
+		}
+
+		OS_EXIT_CRITICAL();
+
+		item.func(item.p_arg, item.data);
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_DeferInit
+* ܣʼӺвע
+* void
+* void
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺û  InitCasyOS ģʼ֮
+*********************************************************************************************************/
+void OS_DeferInit(void)
+{
+	s_OSDeferQ.objType = OS_OBJ_TYPE_DEFER;
+	s_OSDeferQ.inCnt   = 0;
+	s_OSDeferQ.outCnt  = 0;
+	OSRegister(&s_structDeferHandle, OS_DeferTask, "DeferTask", OS_CFG_DEFER_TASK_PRIO, s_arrDeferStack, OS_CFG_DEFER_TASK_STK_SIZE, 0, 0);
+}
+
+/*********************************************************************************************************
+* ƣOSDeferPost
+* ܣǼһӺ
+* func:  p_arg:  data: 
+* void
+*   ֵ1-Ǽǳɹ 0-( overflowCnt)
+* ڣ20260214
+* ע    ⣺
+*           (1) жϺоɵ ٽֻӺһ״̬ж
+*           (2) жеʱ  OSIntExit ʱõ
+*           (3) ʱӡϢ жִкʱ
+*********************************************************************************************************/
+u8 OSDeferPost(OS_DEFER_FUNC func, void *p_arg, u32 data)
+{
+	OS_DEFER_ITEM *p_item;
+	u32 depth;
+	u8 wake = 0;
+
+	if(func == NULL)
+	{
+		printf("ERROR:[OSDeferPost] Illegal argument!\r\n");
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	depth = s_OSDeferQ.inCnt - s_OSDeferQ.outCnt;
+	if(depth >= OS_CFG_DEFER_Q_SIZE)
+	{
+		s_OSDeferOverflow++;
+		OS_EXIT_CRITICAL();
+		return 0;
+	}
+
+	p_item = &s_OSDeferQ.arrItem[s_OSDeferQ.inCnt & OS_DEFER_Q_MASK];
+	p_item->func  = func;
+	p_item->p_arg = p_arg;
+	p_item->data  = data;
+	p_item->stamp = OS_PortTimestampGet();
+	s_OSDeferQ.inCnt++;
+	if(depth + 1 > s_OSDeferDepthMax)
+	{
+		s_OSDeferDepthMax = depth + 1;
+	}
+
+	//ڵȴ ֱӻ
+	if(s_structDeferHandle.state == OS_TASK_PEND && s_structDeferHandle.pendObj == (void*)&s_OSDeferQ)
+	{
+		OS_PendTaskReady(&s_structDeferHandle, OS_PEND_OK);
+		wake = 1;
+	}
+
+	OS_EXIT_CRITICAL();
+
+	if(wake)
+	{
+		OS_Sched();
+	}
+	return 1;
+}
+
+/*********************************************************************************************************
+* ƣOSDeferStatsGet
+* ܣȡӺͳϢ
+* p_stats: ַ
+* p_stats: ͳϢ
+*   ֵvoid
+* ڣ20260214
+* ע    ⣺ӳΪǼǵȡʱ ִʱ
+*********************************************************************************************************/
+void OSDeferStatsGet(OS_DEFER_STATS *p_stats)
+{
+	u32 runCnt;
+	u32 latencyMax;
+	u64 latencySum;
+
+	if(p_stats == NULL)
+	{
+		printf("ERROR:[OSDeferStatsGet] Illegal argument!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+	p_stats->postCnt     = s_OSDeferQ.inCnt;
+	p_stats->overflowCnt = s_OSDeferOverflow;
+	p_stats->depthMax    = s_OSDeferDepthMax;
+	runCnt     = s_OSDeferQ.outCnt;
+	latencyMax = s_OSDeferLatencyMax;
+	latencySum = s_OSDeferLatencySum;
+	OS_EXIT_CRITICAL();
+
+	p_stats->runCnt       = runCnt;
+	p_stats->latencyMaxUs = (u32)((u64)latencyMax * 1000000 / OS_PortTimestampFreq());
+	p_stats->latencyAvgUs = (runCnt == 0) ? 0 : (u32)(latencySum * 1000000 / OS_PortTimestampFreq() / runCnt);
+}
+
+#endif	//OS_CFG_DEFER_EN
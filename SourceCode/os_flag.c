@@ -184,6 +184,7 @@ void OSFlagPost(OS_FLAG *p_flag, u32 mask, OS_FLAG_SET_OPT opt)
     curFlags &= ~mask;
   }
   p_flag->flags = curFlags;
+  OS_TRACE(OS_TRACE_FLAG_POST, p_flag, opt);
 
   //ȴбзҪĸȼȴ ֱӻ
   p_pend_list = &p_flag->pendList;
@@ -199,9 +200,7 @@ void OSFlagPost(OS_FLAG *p_flag, u32 mask, OS_FLAG_SET_OPT opt)
       }
 
       OS_PendListRemove(p_pend_list, p_tcb);
-      OS_RdyTaskAdd(p_tcb);
-      p_tcb->state = OS_TASK_READY;
-      p_tcb->pendObj = NULL;
+      OS_PendTaskReady(p_tcb, OS_PEND_OK);
 
       OS_EXIT_CRITICAL();
       OS_Sched();
@@ -223,25 +222,42 @@ void OSFlagPost(OS_FLAG *p_flag, u32 mask, OS_FLAG_SET_OPT opt)
 *           (1) ǰ flags ֱӷأı־λ
 *           (2) У
 *           (3) ʵеȴɹı־λԵȴ SET_xxx Ч
+*           (4) õȴ ȼ OSFlagPendTimeout(p_flag, mask, opt, OS_WAIT_FOREVER)
 *********************************************************************************************************/
 void OSFlagPend(OS_FLAG *p_flag, u32 mask, OS_FLAG_PEDN_OPT opt)
+{
+  OSFlagPendTimeout(p_flag, mask, opt, OS_WAIT_FOREVER);
+}
+
+/*********************************************************************************************************
+* ƣOSFlagPendTimeout
+* ܣʱȴ¼־ָ
+* p_flag: ¼־ָ mask: ȴλ opt: ȴѡ timeout: ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* void
+*   ֵOS_PEND_OK:  OS_PEND_TIMEOUT: ȴʱ OS_PEND_ERR: 
+* ڣ20260208
+* ע    ⣺ʱʱκα־λ
+*********************************************************************************************************/
+OS_PEND_STAT OSFlagPendTimeout(OS_FLAG *p_flag, u32 mask, OS_FLAG_PEDN_OPT opt, u32 timeout)
 {
   OS_ENTER_CRITICAL();
 
   if(p_flag == NULL || p_flag->objType != OS_OBJ_TYPE_FLAG)
 	{
-		printf("ERROR:[OSFlagPost] Illegal argument!\r\n");
+		printf("ERROR:[OSFlagPend] Illegal argument!\r\n");
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_ERR;
 	}
 
   g_pCurrentTask->flagsMaskPendOn = mask;
   g_pCurrentTask->flagsPendOpt = opt;
 
+  OS_TRACE(OS_TRACE_FLAG_PEND, p_flag, !IsFlagsMatch(p_flag->flags, g_pCurrentTask));
+
   //ǰ־Ѿȴ ֱӷ
   if(IsFlagsMatch(p_flag->flags, g_pCurrentTask))
   {
-    if(opt == OS_FLAG_WAIT_SET_ALL || OS_FLAG_WAIT_SET_ANY)
+    if(opt == OS_FLAG_WAIT_SET_ALL || opt == OS_FLAG_WAIT_SET_ANY)
     {
       //ֻSETȴЧ ı־λ0
       p_flag->flags &= ~mask;
@@ -249,17 +265,25 @@ void OSFlagPend(OS_FLAG *p_flag, u32 mask, OS_FLAG_PEDN_OPT opt)
     g_pCurrentTask->flagsMaskPendOn = 0;
     g_pCurrentTask->flagsPendOpt = OS_FLAG_WAIT_NONE;
     OS_EXIT_CRITICAL();
-    return;
+    return OS_PEND_OK;
   }
   else  //ǰ־鲻
   {
-    OS_RdyTaskRemove(g_pCurrentTask);
-		OS_PendListInsert(&p_flag->pendList, g_pCurrentTask);
-		g_pCurrentTask->state = OS_TASK_PEND;
-		g_pCurrentTask->pendObj = (void*)p_flag;
+    if(OS_SchedIsLocked())
+    {
+      printf("ERROR:[OSFlagPend] Scheduler is locked!\r\n");
+      g_pCurrentTask->flagsMaskPendOn = 0;
+      g_pCurrentTask->flagsPendOpt = OS_FLAG_WAIT_NONE;
+      OS_EXIT_CRITICAL();
+      return OS_PEND_ERR;
+    }
+    OS_PendTaskBlock(&p_flag->pendList, (void*)p_flag, timeout);
     OS_EXIT_CRITICAL();
     OS_Sched();
   }
+
+  // OSFlagPost ѻȴʱص
+  return g_pCurrentTask->pendStat;
 }
 
 #endif //OS_CFG_FLAG_EN
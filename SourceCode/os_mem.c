@@ -6,14 +6,29 @@
 * : 20260115
 *     :
 *           (1) ʹþ̬Ϊڴأs_OSMemoryPool
-*           (2) ʹõڴ飬ÿ ͷ(OS_MEM_NODE) +  
+*           (2) ʹð˳еڴ飬ÿ ͷ(OS_MEM_NODE) +  
 *           (3) ԣ״ First-FitͷʼҵһõĿп飩
 *           (4) ֿ֧֣ʣռ㹻¿п飩
-*           (5) ֧ͷʱǰ/пϲƬ
+*           (5) ֧ͷʱǰ/пϲƬ ͷͬʱ¼ǰڿ ϲΪO(1)
+*           (6) OS_CFG_MEM_TLSF_EN=1 ʱ(TLSF)ͷŶO(1)ʱ޹
+*           (7) OS_CFG_MEM_CHECK_EN=1 ʱṩ OSMemCheck() ڴؼͷǷԽд
+*           (8) ֶ֧ڴڲڴǵһⲿSRAM/CCM  OSMemRegionAdd ע
+*               - ÿ(/DMAɷ) OSMallocFrom ָ OSMallocAttr ָ
+*               - OSMalloc  OS_MEM_FAST_SIZE ȷڿ ȷ
+*           (9) ֽˮλп/ͷ/ʧܴڷͷʱά
+*               OSMemStats/OSMemoryPerused ѯ пɿпֱӵõ(½)
 * ע    :                                                                
-*           (1) ʵڡڴֶ֧ڴ򡢲֧˫
+*           (1) ʵڡڴ򵥶鲻ϲOSFree ַ򣬺ʱ
 *           (2) OS_MEM_NODE->memUsedSize λ桰ռñ־λ桰С
 *           (3) ģнӿڶӦٽУлƻ
+*           (4) TLSF ģ:
+*               - һСλ(2) ÿٵȷΪ OS_MEM_SL_COUNT 
+*                 С OS_MEM_SMALL_SIZE Ŀȫһ0  OS_MEM_ALIGN Ի
+*               - ÿ(һ,)һ˫ һ/λͼ¼Щǿ CLZһλ
+*               - ʱȡϽٲ ҵһ鶼 Ҫ
+*               - ͷڵǰһַ ڴĩβһСΪ0ռÿڱ
+*                 ͷʱǰھӶֱӵõ ϲҪ
+*           (5) OSFree ַֻΧռñ־(ظͷ) ͷǷ OSMemCheck 
 **********************************************************************************************************
 * ȡ汾: 
 *     :
@@ -27,6 +42,7 @@
 *********************************************************************************************************/
 #include "CasyOS.h"
 #include "string.h"
+#include "stddef.h"
 
 #if OS_CFG_MEM_EN != 0u
 /*********************************************************************************************************
@@ -35,11 +51,52 @@
 #define OS_MEM_ALIGN_UP(x)  		  (((x) + (OS_MEM_ALIGN - 1)) & ~(OS_MEM_ALIGN - 1))	//϶
 #define OS_MEM_USED_FLAG     			0x80000000	//ڴǷб־λbit[31] 0- 1-ռ
 #define OS_MEM_SIZE_MASK     			0x7FFFFFFF	//øڴռС
-#define OS_MEM_NODE_SIZE		 			sizeof(OS_MEM_NODE)	//һڴռõĿռ
+#if OS_CFG_MEM_TLSF_EN == 0
+#define OS_MEM_NODE_SIZE		 			OS_MEM_ALIGN_UP(sizeof(OS_MEM_NODE))	//һڴռõĿռ(֤)
+#else
+#define OS_MEM_NODE_SIZE		 			OS_MEM_ALIGN_UP(offsetof(OS_MEM_NODE, memNextFree))	//ռÿĿͷС(ָص)
+#define OS_MEM_BLOCK_MIN					OS_MEM_ALIGN_UP(sizeof(OS_MEM_NODE) - OS_MEM_NODE_SIZE)	//Сֵ(ɿָ)
+
+#if   OS_MEM_ALIGN == 4
+#define OS_MEM_ALIGN_LOG2					2
+#elif OS_MEM_ALIGN == 8
+#define OS_MEM_ALIGN_LOG2					3
+#elif OS_MEM_ALIGN == 16
+#define OS_MEM_ALIGN_LOG2					4
+#elif OS_MEM_ALIGN == 32
+#define OS_MEM_ALIGN_LOG2					5
+#else
+#error "OS_MEM_ALIGN must be 4, 8, 16 or 32 when OS_CFG_MEM_TLSF_EN is set"
+#endif
+
+#define OS_MEM_SL_LOG2						3																				//ÿһ仮ֵĶ(log2)
+#define OS_MEM_SL_COUNT						(1 << OS_MEM_SL_LOG2)										//ÿһ仮ֵĶ
+#define OS_MEM_FL_SHIFT						(OS_MEM_SL_LOG2 + OS_MEM_ALIGN_LOG2)		//ԻֵС(log2)
+#define OS_MEM_SMALL_SIZE					(1 << OS_MEM_FL_SHIFT)									//СڸֵĿ鶼һ0
+#define OS_MEM_FL_INDEX_MAX				20																			//Сλֵ 鲻 2^21 ֽ
+#define OS_MEM_FL_COUNT						(OS_MEM_FL_INDEX_MAX - OS_MEM_FL_SHIFT + 2)	//һ
+
+#if OS_MEM_MAX_SIZE >= (1 << (OS_MEM_FL_INDEX_MAX + 1))
+#error "OS_MEM_MAX_SIZE is too large for OS_MEM_FL_INDEX_MAX"
+#endif
+#endif	//OS_CFG_MEM_TLSF_EN
 
 /*********************************************************************************************************
 *                                              öٽṹ
 *********************************************************************************************************/
+#if OS_CFG_MEM_TLSF_EN != 0
+/*
+ * OS_MEM_TLSF
+ * ܣTLSF п
+ * ˵flBitmap  bit[fl] ʾһ fl һǿ slBitmap[fl]  bit[sl] ʾ freeHead[fl][sl] ǿ
+ */
+typedef struct OS_MEM_TLSF
+{
+	u32						flBitmap;																		//һλͼ
+	u32						slBitmap[OS_MEM_FL_COUNT];									//λͼ
+	OS_MEM_NODE*	freeHead[OS_MEM_FL_COUNT][OS_MEM_SL_COUNT];	//ͷ
+}OS_MEM_TLSF;
+#endif
 
 /*********************************************************************************************************
 *                                              ڲ
@@ -52,33 +109,101 @@ static OS_MEM_DEV s_OSMemoryDev =
 {
   OSInitMemory,     //ڴʼָ
   OSMemoryPerused,  //ڴʹʺָ
-  NULL,   					//ڴʼַ
-  NULL,							//ڴַֹ
-	NULL,							//ڴ
+	NULL,							//ڴ
   OS_MEM_NOT_READY	//ڴδ
 };
 
+static OS_MEM_REGION s_OSMemoryRegion;	//ڲڴضӦ
+#if OS_CFG_MEM_TLSF_EN != 0
+static OS_MEM_TLSF s_OSMemoryTlsf;			//ڲڴص TLSF п(ͷ)
+#endif
+
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
-static void* MallocMemory(u32 size);	//ڴ
+static void* MallocMemory(OS_MEM_REGION *p_region, u32 size);	//ڴ
+static void  FreeMemory(OS_MEM_REGION *p_region, void* ptr);		//ڴͷ
+static void  MemRegionInit(OS_MEM_REGION *p_region);						//ʼΪһп
+static OS_MEM_REGION* MemRegionFind(void *ptr);								//ҵַ
+static void* MemRegionMalloc(OS_MEM_REGION *p_region, u32 size);	//з䲢ͳ
+static u32   MemLargestFree(OS_MEM_REGION *p_region);					//п
+static void  MemStatsGet(OS_MEM_REGION *p_region, OS_MEM_STATS *p_stats);	//ȡͳ
+static void* MemPlace(u32 size, u32 attr);											//Ĭ˳ڸз
+static u32   MemFls(u32 x);																	//λλ
+#if OS_CFG_MEM_TLSF_EN == 0
+static void  MemClassAdd(OS_MEM_REGION *p_region, u32 size);		//пСȼ
+static void  MemClassDel(OS_MEM_REGION *p_region, u32 size);		//пƳСȼ
+#else
+static u32  MemFfs(u32 x);																//λλ
+static void MemMapping(u32 size, u32 *p_fl, u32 *p_sl);	//С -> ±
+static void MemFreeInsert(OS_MEM_TLSF *p_tlsf, OS_MEM_NODE *p_node);	//п
+static void MemFreeRemove(OS_MEM_TLSF *p_tlsf, OS_MEM_NODE *p_node);	//пƳ
+static OS_MEM_NODE* MemNextPhys(OS_MEM_NODE *p_node);		//ڵĺһ
+#endif
+#if OS_CFG_MEM_CHECK_EN != 0
+static const char* MemRegionCheck(OS_MEM_REGION *p_region, OS_MEM_NODE **pp_node);	//пͷ
+#endif
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+/*********************************************************************************************************
+* : MemFls
+* : ȡλλ
+* : x032λ
+* : void
+*   ֵ: λ(0~31)
+* : 20260219
+* ע    : λͼͬ ֻ __builtin_clzCortex-M3/M4 Ϊ CLZ ָ x Ϊ0ʱδ ɵ
+*********************************************************************************************************/
+static u32 MemFls(u32 x)
+{
+	return 31 - __builtin_clz(x);
+}
+
+#if OS_CFG_MEM_TLSF_EN == 0
+/*********************************************************************************************************
+* : MemClassAdd / MemClassDel
+* : п/Ƴ 2 ݻֵĴСȼ
+* : p_regionڴsizeпС
+* : void
+*   ֵ: void
+* : 20260223
+* ע    : 
+*           (1) п֡ʧСıʱ ߵķǿյȼп½ ѯʱ
+*           (2) пСС OS_MEM_ALIGN Ϊ0
+*********************************************************************************************************/
+static void MemClassAdd(OS_MEM_REGION *p_region, u32 size)
+{
+	u32 k = MemFls(size);
+
+	p_region->freeClassCnt[k]++;
+	p_region->freeClassMap |= (1U << k);
+}
+
+static void MemClassDel(OS_MEM_REGION *p_region, u32 size)
+{
+	u32 k = MemFls(size);
+
+	if(--p_region->freeClassCnt[k] == 0)
+	{
+		p_region->freeClassMap &= ~(1U << k);
+	}
+}
+
 /*********************************************************************************************************
 * : MallocMemory
 * : ڴ
-* : memxڴ飻sizeҪڴСֽڣ
+* : p_regionڴsizeҪڴСֽڣ
 * : void
-*   ֵ: void
+*   ֵ: ׵ַ û㹻ĿпʱNULL
 * : 20260115
 * ע    :
 *           (1) úϷԼ飬 OSMalloc() ͳһ
 *           (2) úٽ OSMalloc() ֤
 *           (3) صַ ͷ (currNode + OS_MEM_NODE_SIZE)
 *********************************************************************************************************/
-static void* MallocMemory(u32 size)
+static void* MallocMemory(OS_MEM_REGION *p_region, u32 size)
 {
   OS_MEM_NODE* currNode;
 	OS_MEM_NODE* newNode;
@@ -86,8 +211,12 @@ static void* MallocMemory(u32 size)
 	u32 usedFlag;				//ǰǷʹñ־
 	u32 blockSize;			//ǰĴС
   
+	if(size > (u32)(p_region->memoryEnd - p_region->memoryBase))	//򻹴
+	{
+		return NULL;
+	}
   reqMemSize = OS_MEM_ALIGN_UP(size);  //
-	currNode = s_OSMemoryDev.memoryList;
+	currNode = p_region->memoryList;
 	
 	while(currNode != NULL)
 	{
@@ -97,18 +226,35 @@ static void* MallocMemory(u32 size)
 		//ҵĿûбʹ㹻ռ
 		if(usedFlag == 0 && blockSize >= reqMemSize)
 		{
+			MemClassDel(p_region, blockSize);
+
 			//blockҪڴ Ƿ㹻Ŀռ ԲֳһµĿп
 			if(blockSize >= reqMemSize + OS_MEM_NODE_SIZE + OS_MEM_ALIGN)
 			{
 				newNode = (OS_MEM_NODE*)((u8*)currNode + OS_MEM_NODE_SIZE + reqMemSize);	//ַƫ·ڴ
 				newNode->memUsedSize = (blockSize - reqMemSize - OS_MEM_NODE_SIZE) & OS_MEM_SIZE_MASK;	//²ֵĿÿռСΪδʹ
 				newNode->memNextNode = currNode->memNextNode;	//½뵽ǰ֮
+				newNode->memPrevNode = currNode;
+				if(newNode->memNextNode != NULL)
+				{
+					newNode->memNextNode->memPrevNode = newNode;
+				}
 				currNode->memNextNode = newNode;
 				currNode->memUsedSize = reqMemSize | OS_MEM_USED_FLAG;	//ǰΪʹòռÿռС
+				MemClassAdd(p_region, newNode->memUsedSize);
+				if(blockSize >= p_region->largestFree)	//ܲ largestFree ӦĿ Ϊ¼ʣ
+				{
+					p_region->largestFree = newNode->memUsedSize;
+				}
 			}
 			else	//Ҫ
 			{
 				currNode->memUsedSize |= OS_MEM_USED_FLAG;	//ǰΪʹ
+				p_region->fragNum--;
+				if(blockSize >= p_region->largestFree)
+				{
+					p_region->largestFree = 0;
+				}
 			}
 			return (u8*)currNode + OS_MEM_NODE_SIZE;
 		}
@@ -118,6 +264,725 @@ static void* MallocMemory(u32 size)
   return NULL;	//δҵϷڴ
 }
 
+/*********************************************************************************************************
+* : FreeMemory
+* : ڴͷ
+* : p_regionڴptrڴ׵ַ
+* : void
+*   ֵ: void
+* : 20260115
+* ע    :
+*           (1) úϷԼ飬ٽ OSFree() 
+*           (2) ǰڿ鶼ɿͷֱӵõ ϲǰϲ ʱ޹
+*           (3) ͬʱάпСȼ largestFree
+*********************************************************************************************************/
+static void FreeMemory(OS_MEM_REGION *p_region, void* ptr)
+{
+  OS_MEM_NODE* currNode;
+	OS_MEM_NODE* nextNode;
+	OS_MEM_NODE* prevNode;
+
+	//ɾǰ
+	currNode = (OS_MEM_NODE*)((u8*)ptr - OS_MEM_NODE_SIZE);	//õڴڴͷ
+	currNode->memUsedSize &= OS_MEM_SIZE_MASK;	//ڴռñ־
+	nextNode = currNode->memNextNode;
+	p_region->fragNum++;
+	
+	//Ŀڴϲ
+	if(nextNode != NULL && (nextNode->memUsedSize & OS_MEM_USED_FLAG) == 0)	//滹ڴڴ
+	{
+		MemClassDel(p_region, nextNode->memUsedSize);
+		currNode->memUsedSize = (currNode->memUsedSize & OS_MEM_SIZE_MASK) + (nextNode->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+		currNode->memNextNode = nextNode->memNextNode;
+		if(currNode->memNextNode != NULL)
+		{
+			currNode->memNextNode->memPrevNode = currNode;
+		}
+		p_region->fragNum--;
+	}
+	
+	//ǰĿڴϲ
+	prevNode = currNode->memPrevNode;
+	if(prevNode != NULL && (prevNode->memUsedSize & OS_MEM_USED_FLAG) == 0)	//ǰ滹ڴڴ
+	{
+		MemClassDel(p_region, prevNode->memUsedSize);
+		prevNode->memUsedSize = (prevNode->memUsedSize & OS_MEM_SIZE_MASK) + (currNode->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+		prevNode->memNextNode = currNode->memNextNode;
+		if(prevNode->memNextNode != NULL)
+		{
+			prevNode->memNextNode->memPrevNode = prevNode;
+		}
+		p_region->fragNum--;
+		currNode = prevNode;
+	}
+	
+	//if򲻺ϲ ϲĿСȼ
+	MemClassAdd(p_region, currNode->memUsedSize);
+	if(currNode->memUsedSize > p_region->largestFree)
+	{
+		p_region->largestFree = currNode->memUsedSize;
+	}
+}
+
+#else	//OS_CFG_MEM_TLSF_EN
+/*********************************************************************************************************
+* : MemFfs
+* : ȡλλ
+* : x032λ
+* : void
+*   ֵ: λ(0~31)
+* : 20260219
+* ע    : x Ϊ0ʱδ ɵ
+*********************************************************************************************************/
+static u32 MemFfs(u32 x)
+{
+	return 31 - __builtin_clz(x & (~x + 1));	//x & -x ֻλλ
+}
+
+/*********************************************************************************************************
+* : MemMapping
+* : ɿСڿ±
+* : sizeСѶ룩
+* : p_flһ± p_sl±
+*   ֵ: void
+* : 20260219
+* ע    : 
+*           (1) С OS_MEM_SMALL_SIZE ʱ fl=0 sl=size/OS_MEM_ALIGN
+*           (2)  fl λλ sl Ϊλ֮ OS_MEM_SL_LOG2 λ
+*********************************************************************************************************/
+static void MemMapping(u32 size, u32 *p_fl, u32 *p_sl)
+{
+	u32 fl;
+
+	if(size < OS_MEM_SMALL_SIZE)
+	{
+		*p_fl = 0;
+		*p_sl = size >> OS_MEM_ALIGN_LOG2;
+	}
+	else
+	{
+		fl = MemFls(size);
+		*p_sl = (size >> (fl - OS_MEM_SL_LOG2)) ^ OS_MEM_SL_COUNT;
+		*p_fl = fl - OS_MEM_FL_SHIFT + 1;
+	}
+}
+
+/*********************************************************************************************************
+* : MemNextPhys
+* : ȡڵĺһ
+* : p_nodeڴ
+* : void
+*   ֵ: һĿͷ
+* : 20260219
+* ע    : ڴĩβڱ һʵʵĿʱڱ ڱӦ
+*********************************************************************************************************/
+static OS_MEM_NODE* MemNextPhys(OS_MEM_NODE *p_node)
+{
+	return (OS_MEM_NODE*)((u8*)p_node + OS_MEM_NODE_SIZE + (p_node->memUsedSize & OS_MEM_SIZE_MASK));
+}
+
+/*********************************************************************************************************
+* : MemFreeInsert
+* : ѿпӦͷ λλͼ
+* : p_tlsfp_nodeп
+* : void
+*   ֵ: void
+* : 20260219
+* ע    : 
+*********************************************************************************************************/
+static void MemFreeInsert(OS_MEM_TLSF *p_tlsf, OS_MEM_NODE *p_node)
+{
+	OS_MEM_NODE *p_head;
+	u32 fl;
+	u32 sl;
+
+	MemMapping(p_node->memUsedSize & OS_MEM_SIZE_MASK, &fl, &sl);
+	p_head = p_tlsf->freeHead[fl][sl];
+	p_node->memPrevFree = NULL;
+	p_node->memNextFree = p_head;
+	if(p_head != NULL)
+	{
+		p_head->memPrevFree = p_node;
+	}
+	p_tlsf->freeHead[fl][sl] = p_node;
+	p_tlsf->slBitmap[fl] |= (1U << sl);
+	p_tlsf->flBitmap |= (1U << fl);
+}
+
+/*********************************************************************************************************
+* : MemFreeRemove
+* : ѿпƳ ʱλͼ
+* : p_tlsfp_nodeп
+* : void
+*   ֵ: void
+* : 20260219
+* ע    : 
+*********************************************************************************************************/
+static void MemFreeRemove(OS_MEM_TLSF *p_tlsf, OS_MEM_NODE *p_node)
+{
+	u32 fl;
+	u32 sl;
+
+	MemMapping(p_node->memUsedSize & OS_MEM_SIZE_MASK, &fl, &sl);
+	if(p_node->memPrevFree != NULL)
+	{
+		p_node->memPrevFree->memNextFree = p_node->memNextFree;
+	}
+	else
+	{
+		p_tlsf->freeHead[fl][sl] = p_node->memNextFree;
+	}
+	if(p_node->memNextFree != NULL)
+	{
+		p_node->memNextFree->memPrevFree = p_node->memPrevFree;
+	}
+
+	if(p_tlsf->freeHead[fl][sl] == NULL)
+	{
+		p_tlsf->slBitmap[fl] &= ~(1U << sl);
+		if(p_tlsf->slBitmap[fl] == 0)
+		{
+			p_tlsf->flBitmap &= ~(1U << fl);
+		}
+	}
+}
+
+/*********************************************************************************************************
+* : MallocMemory
+* : ڴ(TLSF)
+* : p_regionڴsizeҪڴСֽڣ
+* : void
+*   ֵ: ׵ַ û㹻ĿпʱNULL
+* : 20260219
+* ע    :
+*           (1) úϷԼ飬ٽ OSMalloc() 
+*           (2) ȡڶϽ 估еһ鶼 ȡͷ
+*           (3) ͬһҲС sl ķǿ ûҸһ λͼҾΪO(1)
+*           (4) Ϊʱ ٿͷǷ(ӽڴصһ)
+*           (5) ʣಿ㹻һʱ ʣ¼
+*********************************************************************************************************/
+static void* MallocMemory(OS_MEM_REGION *p_region, u32 size)
+{
+	OS_MEM_TLSF *p_tlsf;
+	OS_MEM_NODE *currNode;
+	OS_MEM_NODE *newNode;
+	u32 reqMemSize;
+	u32 blockSize;
+	u32 fl;
+	u32 sl;
+	u32 map;
+
+	if(size > (u32)(p_region->memoryEnd - p_region->memoryBase))	//򻹴 ±Խ
+	{
+		return NULL;
+	}
+	p_tlsf = p_region->memoryTlsf;
+	reqMemSize = OS_MEM_ALIGN_UP(size);
+	if(reqMemSize < OS_MEM_BLOCK_MIN)
+	{
+		reqMemSize = OS_MEM_BLOCK_MIN;
+	}
+
+	//ȡϽ±
+	currNode = NULL;
+	if(reqMemSize >= OS_MEM_SMALL_SIZE)
+	{
+		MemMapping(reqMemSize + (1U << (MemFls(reqMemSize) - OS_MEM_SL_LOG2)) - 1, &fl, &sl);
+	}
+	else
+	{
+		MemMapping(reqMemSize, &fl, &sl);
+	}
+
+	//ҲС(fl, sl)ĵһǿ
+	if(fl < OS_MEM_FL_COUNT)
+	{
+		map = p_tlsf->slBitmap[fl] & (~0U << sl);
+		if(map == 0)
+		{
+			map = p_tlsf->flBitmap & (~0U << (fl + 1));
+			if(map != 0)
+			{
+				fl = MemFfs(map);
+				map = p_tlsf->slBitmap[fl];
+			}
+		}
+		if(map != 0)
+		{
+			currNode = p_tlsf->freeHead[fl][MemFfs(map)];
+		}
+	}
+
+	//ͷ
+	if(currNode == NULL)
+	{
+		MemMapping(reqMemSize, &fl, &sl);
+		currNode = p_tlsf->freeHead[fl][sl];
+		if(currNode == NULL || (currNode->memUsedSize & OS_MEM_SIZE_MASK) < reqMemSize)
+		{
+			return NULL;
+		}
+	}
+
+	MemFreeRemove(p_tlsf, currNode);
+	blockSize = currNode->memUsedSize & OS_MEM_SIZE_MASK;
+	p_region->fragNum--;
+
+	//ʣռ㹻һ ֳµĿп
+	if(blockSize >= reqMemSize + OS_MEM_NODE_SIZE + OS_MEM_BLOCK_MIN)
+	{
+		newNode = (OS_MEM_NODE*)((u8*)currNode + OS_MEM_NODE_SIZE + reqMemSize);
+		newNode->memUsedSize = blockSize - reqMemSize - OS_MEM_NODE_SIZE;
+		newNode->memPrevPhys = currNode;
+		MemNextPhys(newNode)->memPrevPhys = newNode;
+		currNode->memUsedSize = reqMemSize;
+		MemFreeInsert(p_tlsf, newNode);
+		p_region->fragNum++;
+	}
+	currNode->memUsedSize |= OS_MEM_USED_FLAG;
+
+	return (u8*)currNode + OS_MEM_NODE_SIZE;
+}
+
+/*********************************************************************************************************
+* : FreeMemory
+* : ڴͷ(TLSF)
+* : p_regionڴptrڴ׵ַ
+* : void
+*   ֵ: void
+* : 20260219
+* ע    :
+*           (1) úϷԼ飬ٽ OSFree() 
+*           (2) ǰһɿͷֱӵõ һɵַӴСõ ʱƳٺϲ ϲ
+*           (3) ڱʼΪռ״̬ һ鲻Խڴĩβϲ
+*********************************************************************************************************/
+static void FreeMemory(OS_MEM_REGION *p_region, void* ptr)
+{
+	OS_MEM_TLSF *p_tlsf = p_region->memoryTlsf;
+	OS_MEM_NODE *currNode;
+	OS_MEM_NODE *prevNode;
+	OS_MEM_NODE *nextNode;
+
+	currNode = (OS_MEM_NODE*)((u8*)ptr - OS_MEM_NODE_SIZE);
+	currNode->memUsedSize &= OS_MEM_SIZE_MASK;
+
+	//Ŀпϲ
+	nextNode = MemNextPhys(currNode);
+	if((nextNode->memUsedSize & OS_MEM_USED_FLAG) == 0)
+	{
+		MemFreeRemove(p_tlsf, nextNode);
+		currNode->memUsedSize += OS_MEM_NODE_SIZE + nextNode->memUsedSize;
+		MemNextPhys(currNode)->memPrevPhys = currNode;
+		p_region->fragNum--;
+	}
+
+	//ǰĿпϲ
+	prevNode = currNode->memPrevPhys;
+	if(prevNode != NULL && (prevNode->memUsedSize & OS_MEM_USED_FLAG) == 0)
+	{
+		MemFreeRemove(p_tlsf, prevNode);
+		prevNode->memUsedSize += OS_MEM_NODE_SIZE + currNode->memUsedSize;
+		MemNextPhys(prevNode)->memPrevPhys = prevNode;
+		p_region->fragNum--;
+		currNode = prevNode;
+	}
+
+	MemFreeInsert(p_tlsf, currNode);
+	p_region->fragNum++;
+}
+#endif	//OS_CFG_MEM_TLSF_EN
+
+/*********************************************************************************************************
+* : MemRegionInit
+* : ʼΪһĴп
+* : p_regionڴ(memoryBase/memoryEnd/memoryTlsf )
+* : void
+*   ֵ: void
+* : 20260222
+* ע    :
+*           (1) ٽ ɵ߸
+*           (2) TLSF ʱĩβһΪڱ ڱΪСΪ0ռÿ Ŀռ
+*           (3) ͳƼͬʱ ֽ
+*********************************************************************************************************/
+static void MemRegionInit(OS_MEM_REGION *p_region)
+{
+	OS_MEM_NODE *headNode;
+#if OS_CFG_MEM_TLSF_EN != 0
+	OS_MEM_NODE *tailNode;
+#endif
+
+	headNode = (OS_MEM_NODE*)p_region->memoryBase;
+#if OS_CFG_MEM_TLSF_EN == 0
+	//ǵһڴΪδʹ СΪȥڴͷ
+	headNode->memUsedSize = ((u32)(p_region->memoryEnd - p_region->memoryBase) - OS_MEM_NODE_SIZE) & OS_MEM_SIZE_MASK;
+	headNode->memNextNode = NULL;
+	headNode->memPrevNode = NULL;
+#else
+	memset(p_region->memoryTlsf, 0, sizeof(OS_MEM_TLSF));
+	headNode->memUsedSize = ((u32)(p_region->memoryEnd - p_region->memoryBase) - OS_MEM_NODE_SIZE - OS_MEM_ALIGN_UP(sizeof(OS_MEM_NODE))) & OS_MEM_SIZE_MASK;
+	headNode->memPrevPhys = NULL;
+	tailNode = MemNextPhys(headNode);
+	tailNode->memUsedSize = 0 | OS_MEM_USED_FLAG;
+	tailNode->memPrevPhys = headNode;
+	MemFreeInsert(p_region->memoryTlsf, headNode);
+#endif
+	p_region->memoryList = headNode;
+
+	p_region->freeBytes = (u32)(p_region->memoryEnd - p_region->memoryBase);
+	p_region->freeMin   = p_region->freeBytes;
+	p_region->fragNum   = 1;
+	p_region->allocCnt  = 0;
+	p_region->freeCnt   = 0;
+	p_region->failCnt   = 0;
+#if OS_CFG_MEM_TLSF_EN == 0
+	memset(p_region->freeClassCnt, 0, sizeof(p_region->freeClassCnt));
+	p_region->freeClassMap = 0;
+	MemClassAdd(p_region, headNode->memUsedSize);
+	p_region->largestFree = headNode->memUsedSize;
+#endif
+}
+
+/*********************************************************************************************************
+* : MemRegionFind
+* : ҵַڴ
+* : ptrַ
+* : void
+*   ֵ:  κʱNULL
+* : 20260222
+* ע    : ע˳Ƚ߽ ʱ
+*********************************************************************************************************/
+static OS_MEM_REGION* MemRegionFind(void *ptr)
+{
+	OS_MEM_REGION *p_region;
+
+	for(p_region = s_OSMemoryDev.regionList; p_region != NULL; p_region = p_region->nextRegion)
+	{
+		if((u8*)ptr >= p_region->memoryBase && (u8*)ptr < p_region->memoryEnd)
+		{
+			return p_region;
+		}
+	}
+	return NULL;
+}
+
+/*********************************************************************************************************
+* : MemRegionMalloc
+* : з䲢ͳ
+* : p_regionڴsizeڴСֽڣ
+* : void
+*   ֵ: ׵ַ û㹻ĿпʱNULL
+* : 20260223
+* ע    : ٽ ɵ߸ ʧܴɵͳ(OSMalloc һ᳢Զ)
+*********************************************************************************************************/
+static void* MemRegionMalloc(OS_MEM_REGION *p_region, u32 size)
+{
+	void *ptr;
+	u32 bytes;
+
+	ptr = MallocMemory(p_region, size);
+	if(ptr != NULL)
+	{
+		bytes = (((OS_MEM_NODE*)((u8*)ptr - OS_MEM_NODE_SIZE))->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+		p_region->freeBytes -= bytes;
+		p_region->allocCnt++;
+		if(p_region->freeBytes < p_region->freeMin)
+		{
+			p_region->freeMin = p_region->freeBytes;
+		}
+		s_OSMemoryDev.freeBytes -= bytes;
+		if(s_OSMemoryDev.freeBytes < s_OSMemoryDev.freeMin)
+		{
+			s_OSMemoryDev.freeMin = s_OSMemoryDev.freeBytes;
+		}
+	}
+	return ptr;
+}
+
+/*********************************************************************************************************
+* : MemLargestFree
+* : ȡпС½
+* : p_regionڴ
+* : void
+*   ֵ: һڲСڸֵĿп ûппʱΪ0
+* : 20260223
+* ע    :
+*           (1) ٽ ɵ߸ O(1) κ
+*           (2) TLSF ʱȡλͼķǿͷ ʵֵͬһ( 1/OS_MEM_SL_COUNT)
+*           (3) ״ʱȡ largestFree ߷ǿմСȼеĽϴ ʵֵһ
+*               largestFree ٵĿͨ(ĩβĴп) ʱǾȷ
+*           (4) ֵһܷɹ(TLSF ʱͷ)
+*********************************************************************************************************/
+static u32 MemLargestFree(OS_MEM_REGION *p_region)
+{
+	u32 largest;
+#if OS_CFG_MEM_TLSF_EN != 0
+	OS_MEM_TLSF *p_tlsf = p_region->memoryTlsf;
+	u32 fl;
+#endif
+
+	largest = 0;
+#if OS_CFG_MEM_TLSF_EN == 0
+	largest = p_region->largestFree;
+	if(p_region->freeClassMap != 0 && (1U << MemFls(p_region->freeClassMap)) > largest)
+	{
+		largest = 1U << MemFls(p_region->freeClassMap);
+	}
+#else
+	if(p_tlsf->flBitmap != 0)
+	{
+		fl = MemFls(p_tlsf->flBitmap);
+		largest = p_tlsf->freeHead[fl][MemFls(p_tlsf->slBitmap[fl])]->memUsedSize;
+	}
+#endif
+	return largest;
+}
+
+/*********************************************************************************************************
+* : MemStatsGet
+* : ȡʹƬͳ
+* : p_regionڴ
+* : p_statsͳϢ
+*   ֵ: void
+* : 20260223
+* ע    : ٽ ɵ߸
+*********************************************************************************************************/
+static void MemStatsGet(OS_MEM_REGION *p_region, OS_MEM_STATS *p_stats)
+{
+	p_stats->totalBytes  = (u32)(p_region->memoryEnd - p_region->memoryBase);
+	p_stats->freeBytes   = p_region->freeBytes;
+	p_stats->freeMin     = p_region->freeMin;
+	p_stats->largestFree = MemLargestFree(p_region);
+	p_stats->fragNum     = p_region->fragNum;
+	p_stats->allocCnt    = p_region->allocCnt;
+	p_stats->freeCnt     = p_region->freeCnt;
+	p_stats->failCnt     = p_region->failCnt;
+}
+
+/*********************************************************************************************************
+* : MemPlace
+* : Ĭ˳ھָԵз
+* : sizeڴСֽڣattrе(0 ʾ)
+* : void
+*   ֵ: ׵ַ 򶼷ʧʱNULL
+* : 20260222
+* ע    :
+*           (1) ٽ ɵ߸
+*           (2)  OS_MEM_FAST_SIZE Կ  ෴
+*               ȴ洢ƵʵС 󻺳ŵⲿSRAM
+*           (3) ͬһаע˳ ڲڴǵһ
+*********************************************************************************************************/
+static void* MemPlace(u32 size, u32 attr)
+{
+	OS_MEM_REGION *p_region;
+	void *ptr;
+	u8 fastFirst;
+	u8 pass;
+	u8 isFast;
+
+	fastFirst = (size <= OS_MEM_FAST_SIZE);
+	for(pass = 0; pass < 2; pass++)
+	{
+		for(p_region = s_OSMemoryDev.regionList; p_region != NULL; p_region = p_region->nextRegion)
+		{
+			isFast = ((p_region->attr & OS_MEM_ATTR_FAST) != 0);
+			if((p_region->attr & attr) != attr || (isFast == fastFirst) != (pass == 0))
+			{
+				continue;
+			}
+			ptr = MemRegionMalloc(p_region, size);
+			if(ptr != NULL)
+			{
+				return ptr;
+			}
+		}
+	}
+	return NULL;
+}
+
+#if OS_CFG_MEM_CHECK_EN != 0
+/*********************************************************************************************************
+* : MemRegionCheck
+* : ˳ ͷǰǷһ
+* : p_regionڴ
+* : pp_nodeĿ(ΪNULL)
+*   ֵ: NULL-һ Ϊ
+* : 20260221
+* ע    : ٽ  OSMemCheck 
+*********************************************************************************************************/
+static const char* MemRegionCheck(OS_MEM_REGION *p_region, OS_MEM_NODE **pp_node)
+{
+	OS_MEM_NODE *curr;
+	OS_MEM_NODE *prev;
+	OS_MEM_NODE *next;
+	const char  *p_err;
+	u32 usedBytes;
+	u32 freeNum;
+#if OS_CFG_MEM_TLSF_EN == 0
+	u32 classSum;
+	u32 classNum;
+	u32 maxFree;
+	u8  witness;
+	u32 k;
+#else
+	u8 *tail;
+	u32 listNum;
+	u32 fl;
+	u32 sl;
+#endif
+
+	p_err     = NULL;
+	prev      = NULL;
+	curr      = p_region->memoryList;
+	usedBytes = 0;
+	freeNum   = 0;
+#if OS_CFG_MEM_TLSF_EN == 0
+	classSum  = 0;
+	maxFree   = 0;
+	witness   = (p_region->largestFree == 0);
+	while(curr != NULL)
+	{
+		if((u8*)curr < p_region->memoryBase || (u8*)curr + OS_MEM_NODE_SIZE > p_region->memoryEnd ||
+		   ((u8*)curr - p_region->memoryBase) % OS_MEM_ALIGN != 0)
+		{
+			p_err = "header out of region";
+			break;
+		}
+		if(curr->memPrevNode != prev)
+		{
+			p_err = "previous link broken";
+			break;
+		}
+		if(prev != NULL && (prev->memUsedSize & OS_MEM_USED_FLAG) == 0 && (curr->memUsedSize & OS_MEM_USED_FLAG) == 0)
+		{
+			p_err = "adjacent free blocks not merged";
+			break;
+		}
+
+		next = (OS_MEM_NODE*)((u8*)curr + OS_MEM_NODE_SIZE + (curr->memUsedSize & OS_MEM_SIZE_MASK));
+		if(curr->memNextNode == NULL ? (u8*)next != p_region->memoryEnd : curr->memNextNode != next)
+		{
+			p_err = "size does not match next block";
+			break;
+		}
+		if((curr->memUsedSize & OS_MEM_USED_FLAG) != 0)
+		{
+			usedBytes += (curr->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+		}
+		else
+		{
+			freeNum++;
+			classSum += MemFls(curr->memUsedSize);
+			if(curr->memUsedSize > maxFree)
+			{
+				maxFree = curr->memUsedSize;
+			}
+			if(curr->memUsedSize == p_region->largestFree)
+			{
+				witness = 1;
+			}
+		}
+		prev = curr;
+		curr = curr->memNextNode;
+	}
+
+	//Сȼһ(ȼ֮͡ߵȼ) largestFree ĳпĴС
+	if(p_err == NULL)
+	{
+		classNum = 0;
+		for(k = 0; k < 32; k++)
+		{
+			classNum += p_region->freeClassCnt[k];
+			classSum -= p_region->freeClassCnt[k] * k;
+			if(((p_region->freeClassMap >> k) & 1) != (p_region->freeClassCnt[k] != 0))
+			{
+				break;
+			}
+		}
+		if(k < 32 || classNum != freeNum || classSum != 0 || !witness ||
+		   (maxFree != 0 ? MemFls(p_region->freeClassMap) != MemFls(maxFree) : p_region->freeClassMap != 0))
+		{
+			curr  = NULL;
+			p_err = "size class index out of sync";
+		}
+	}
+#else
+	tail    = p_region->memoryEnd - OS_MEM_ALIGN_UP(sizeof(OS_MEM_NODE));	//ڱλ
+	while(1)
+	{
+		if((u8*)curr < p_region->memoryBase || (u8*)curr > tail ||
+		   ((u8*)curr - p_region->memoryBase) % OS_MEM_ALIGN != 0)
+		{
+			p_err = "header out of region";
+			break;
+		}
+		if(curr->memPrevPhys != prev)
+		{
+			p_err = "previous link broken";
+			break;
+		}
+		if((u8*)curr == tail)
+		{
+			if(curr->memUsedSize != (0 | OS_MEM_USED_FLAG))
+			{
+				p_err = "sentinel overwritten";
+			}
+			break;
+		}
+		if((curr->memUsedSize & OS_MEM_USED_FLAG) == 0)
+		{
+			if(prev != NULL && (prev->memUsedSize & OS_MEM_USED_FLAG) == 0)
+			{
+				p_err = "adjacent free blocks not merged";
+				break;
+			}
+			freeNum++;
+		}
+		else
+		{
+			usedBytes += (curr->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+		}
+		prev = curr;
+		curr = MemNextPhys(curr);
+	}
+
+	//еĿһ  freeNum ֹͣ ֹɻ
+	listNum = 0;
+	for(fl = 0; p_err == NULL && fl < OS_MEM_FL_COUNT; fl++)
+	{
+		for(sl = 0; p_err == NULL && sl < OS_MEM_SL_COUNT; sl++)
+		{
+			for(next = p_region->memoryTlsf->freeHead[fl][sl]; next != NULL; next = next->memNextFree)
+			{
+				curr = next;
+				if(++listNum > freeNum || (u8*)next < p_region->memoryBase || (u8*)next >= tail ||
+				   (next->memUsedSize & OS_MEM_USED_FLAG) != 0)
+				{
+					p_err = "free list broken";
+					break;
+				}
+			}
+		}
+	}
+	if(p_err == NULL && listNum != freeNum)
+	{
+		curr  = NULL;
+		p_err = "free block missing from index";
+	}
+#endif
+
+	//άͳһ
+	if(p_err == NULL && (p_region->freeBytes != (u32)(p_region->memoryEnd - p_region->memoryBase) - usedBytes ||
+	                     p_region->fragNum != freeNum))
+	{
+		curr  = NULL;
+		p_err = "statistics out of sync";
+	}
+
+	*pp_node = curr;
+	return p_err;
+}
+#endif	//OS_CFG_MEM_CHECK_EN
+
 /*********************************************************************************************************
 *                                              APIʵ
 *********************************************************************************************************/
@@ -129,32 +994,127 @@ static void* MallocMemory(u32 size)
 *   ֵ: void
 * : 20260115
 * ע    :
-*           (1) ʼֻһп飨ڴ
-*           (2) úκ OSMalloc/OSFree ֮ǰִ
+*           (1) ʼڲڴֻһп飨ڴ
+*           (2) úκ OSMalloc/OSFree/OSMemRegionAdd ֮ǰִ
+*           (3) ظڴ ʱ֮ǰעҲƳ
 *********************************************************************************************************/
 void OSInitMemory(void)
 {
-	OS_MEM_NODE *headNode;
-
 	OS_ENTER_CRITICAL();
 
-	//ʼڴʼַ
-	s_OSMemoryDev.memoryBase  = s_OSMemoryPool;
-	s_OSMemoryDev.memoryEnd   = s_OSMemoryPool + OS_MEM_MAX_SIZE;
-
-	//ʼһڴ
-	headNode = (OS_MEM_NODE*)s_OSMemoryDev.memoryBase;
-	//ǵһڴΪδʹ СΪڴؼȥڴͷ
-	headNode->memUsedSize = (OS_MEM_MAX_SIZE - OS_MEM_NODE_SIZE) & OS_MEM_SIZE_MASK;
-	headNode->memNextNode = NULL;
+	//ڲڴΪһ
+	s_OSMemoryRegion.name       = (u8*)"SRAM";
+	s_OSMemoryRegion.attr       = OS_MEM_POOL_ATTR;
+	s_OSMemoryRegion.memoryBase = s_OSMemoryPool;
+	s_OSMemoryRegion.memoryEnd  = s_OSMemoryPool + OS_MEM_MAX_SIZE;
+#if OS_CFG_MEM_TLSF_EN != 0
+	s_OSMemoryRegion.memoryTlsf = &s_OSMemoryTlsf;
+#endif
+	s_OSMemoryRegion.nextRegion = NULL;
+	MemRegionInit(&s_OSMemoryRegion);
 
 	//λɳʼ־
-	s_OSMemoryDev.memoryList = headNode;
+	s_OSMemoryDev.regionList = &s_OSMemoryRegion;
 	s_OSMemoryDev.memoryRdy  = OS_MEM_READY;
+	s_OSMemoryDev.freeBytes  = s_OSMemoryRegion.freeBytes;
+	s_OSMemoryDev.freeMin    = s_OSMemoryRegion.freeBytes;
+	s_OSMemoryDev.failCnt    = 0;
 
 	OS_EXIT_CRITICAL();
 }
 
+/*********************************************************************************************************
+* : OSMemRegionAdd
+* : עһڴ ֮ OSMalloc/OSFree ʹ
+* : p_regionƿ飻p_nameƣp_addr׵ַsizeСֽڣ
+*           attrԣOS_MEM_ATTR_xxx ϣ
+* : void
+*   ֵ: 1-ɹ 0-̫С/̫עص
+* : 20260222
+* ע    :
+*           (1) β OS_MEM_ALIGN ʹ TLSF ʱпͷ
+*           (2) ⲿSRAMڵǰ EXMC  ĩβ ͬһַ֮
+*           (3) עƳ OSInitMemory ע
+*           (4) ѵĿֽڵˮλĴС һֱڼ
+*           (5) ص鸲ͷ Լ(ڲڴصΪ̬)
+*********************************************************************************************************/
+u8 OSMemRegionAdd(OS_MEM_REGION *p_region, u8 *p_name, void *p_addr, u32 size, u32 attr)
+{
+	OS_MEM_REGION *p_iter;
+	OS_MEM_REGION *p_tail;
+	u8 *start;
+	u8 *end;
+	u8 *base;
+	u8  overlap;
+
+	if(p_region == NULL || p_addr == NULL || size == 0)
+	{
+		printf("ERROR: [OSMemRegionAdd] Illegal Argument!\r\n");
+		return 0;
+	}
+
+	//β TLSF ʱ
+	start = (u8*)OS_MEM_ALIGN_UP((size_t)p_addr);
+	end   = (u8*)(((size_t)p_addr + size) & ~(size_t)(OS_MEM_ALIGN - 1));
+#if OS_CFG_MEM_TLSF_EN == 0
+	base  = start;
+	if(end <= base || (u32)(end - base) < OS_MEM_NODE_SIZE + OS_MEM_ALIGN || (u32)(end - base) > OS_MEM_SIZE_MASK)
+#else
+	base  = start + OS_MEM_ALIGN_UP(sizeof(OS_MEM_TLSF));
+	if(end <= base || (u32)(end - base) < OS_MEM_NODE_SIZE + OS_MEM_BLOCK_MIN + OS_MEM_ALIGN_UP(sizeof(OS_MEM_NODE)) ||
+	   (u32)(end - base) >= (1U << (OS_MEM_FL_INDEX_MAX + 1)))
+#endif
+	{
+		printf("ERROR: [OSMemRegionAdd] Region %s is too small or too large!\r\n", p_name);
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(s_OSMemoryDev.memoryRdy == OS_MEM_NOT_READY)
+	{
+		OS_EXIT_CRITICAL();
+		printf("ERROR: MemoryPool Not Ready!\r\n");
+		return 0;
+	}
+
+	//ظע Ҳص
+	p_tail = NULL;
+	for(p_iter = s_OSMemoryDev.regionList; p_iter != NULL; p_iter = p_iter->nextRegion)
+	{
+		overlap = (start < p_iter->memoryEnd && end > p_iter->memoryBase);
+#if OS_CFG_MEM_TLSF_EN != 0
+		// memoryBase ֮ Ƚ дλͼͷͬƻ
+		overlap = overlap || (start < (u8*)(p_iter->memoryTlsf + 1) && end > (u8*)p_iter->memoryTlsf);
+#endif
+		if(p_iter == p_region || overlap)
+		{
+			OS_EXIT_CRITICAL();
+			printf("ERROR: [OSMemRegionAdd] Region %s overlaps %s!\r\n", p_name, p_iter->name);
+			return 0;
+		}
+		p_tail = p_iter;
+	}
+
+	p_region->name       = p_name;
+	p_region->attr       = attr;
+	p_region->memoryBase = base;
+	p_region->memoryEnd  = end;
+#if OS_CFG_MEM_TLSF_EN != 0
+	p_region->memoryTlsf = (OS_MEM_TLSF*)start;
+#endif
+	p_region->nextRegion = NULL;
+	MemRegionInit(p_region);
+	p_tail->nextRegion   = p_region;
+
+	//ȫ ѵĿֽˮλͬʱ
+	s_OSMemoryDev.freeBytes += p_region->freeBytes;
+	s_OSMemoryDev.freeMin   += p_region->freeBytes;
+
+	OS_EXIT_CRITICAL();
+	return 1;
+}
+
 /*********************************************************************************************************
 * : MemoryPerused
 * : ڴʹ
@@ -164,38 +1124,67 @@ void OSInitMemory(void)
 * : 20260115
 * ע    :
 *           (1) ͳƿھСռÿ顱 (С + ͷС)  used
-*           (2) total = memoryEnd - memoryBaseڴشС
+*           (2) total ΪС֮ͣTLSF ʱͷ
 *           (3) ֵ10 235 ʾ 23.5%
+*           (4) ɷ/ͷʱάĿֽ  ʹ OSMemRegionPerused ȡ
 *********************************************************************************************************/
 u16 OSMemoryPerused(void)
 {
-  OS_MEM_NODE* curr;
+	OS_MEM_REGION *p_region;
   u32 used;
 	u32 total;
 
 	OS_ENTER_CRITICAL();
-	
-	used = 0;
-	total = s_OSMemoryDev.memoryEnd - s_OSMemoryDev.memoryBase;
 
-	curr = s_OSMemoryDev.memoryList;
-	while(curr != NULL)	//ڴ
+	total = 0;
+	for(p_region = s_OSMemoryDev.regionList; p_region != NULL; p_region = p_region->nextRegion)
 	{
-		if((curr->memUsedSize & OS_MEM_USED_FLAG) != 0)	//ۼбռڴĴС
-		{
-			used += (curr->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
-		}
-		curr = curr->memNextNode;
+		total += p_region->memoryEnd - p_region->memoryBase;
 	}
+	used = total - s_OSMemoryDev.freeBytes;
 
 	OS_EXIT_CRITICAL();
-	return (used * 1000) / total;  
+	return (total == 0) ? 0 : (u16)(((u64)used * 1000) / total);
+}
+
+/*********************************************************************************************************
+* : OSMemRegionPerused
+* : ָڴʹ
+* : p_regionڴ NULL ʾڲڴ
+* : void
+*   ֵ: ʹʣ100~10000.0%~100.0%
+* : 20260222
+* ע    : ͳƿھ OSMemoryPerused ͬ
+*********************************************************************************************************/
+u16 OSMemRegionPerused(OS_MEM_REGION *p_region)
+{
+	u32 used;
+	u32 total;
+
+	if(p_region == NULL)
+	{
+		p_region = &s_OSMemoryRegion;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(p_region->memoryList == NULL)
+	{
+		OS_EXIT_CRITICAL();
+		printf("ERROR: [OSMemRegionPerused] Region Not Ready!\r\n");
+		return 0;
+	}
+	total = p_region->memoryEnd - p_region->memoryBase;
+	used  = total - p_region->freeBytes;
+
+	OS_EXIT_CRITICAL();
+	return (u16)(((u64)used * 1000) / total);
 }
 
 /*********************************************************************************************************
 * : OSMalloc
 * : ڴ
-* : memxڴ飻sizeڴСֽڣ
+* : sizeڴСֽڣ
 * : void
 *   ֵ: 䵽ڴ׵ַ
 * : 20260115
@@ -203,15 +1192,32 @@ u16 OSMemoryPerused(void)
 *           (1) ṵ́߳ȫģٽ
 *           (2) ʧܻӡϢ
 *           (3) ɹص׵ֱַдû
+*           (4)  OS_MEM_FAST_SIZE ʱڿ  ʱٻһ
 *********************************************************************************************************/
 void* OSMalloc(u32 size)
+{
+	return OSMallocAttr(size, 0);
+}
+
+/*********************************************************************************************************
+* : OSMallocAttr
+* : ӾָԵڴ
+* : sizeڴСֽڣattrеԣOS_MEM_ATTR_xxx  0 ʾޣ
+* : void
+*   ֵ: 䵽ڴ׵ַ ʧʱNULL
+* : 20260222
+* ע    :
+*           (1) DMA  OS_MEM_ATTR_DMA  ֤ CCM  DMA ܷʵ
+*           (2) Եа OSMalloc Ĭ˳
+*********************************************************************************************************/
+void* OSMallocAttr(u32 size, u32 attr)
 {
   void* ptr;
 
 	OS_ENTER_CRITICAL();
 
 	//
-	if(size == 0 || size >= OS_MEM_MAX_SIZE)
+	if(size == 0 || size > OS_MEM_SIZE_MASK)
 	{
 		printf("ERROR: [OSMalloc] Illegal Argument!\r\n");
 		OS_EXIT_CRITICAL();
@@ -223,13 +1229,14 @@ void* OSMalloc(u32 size)
 	{
 		printf("ERROR: MemoryPool Not Ready!\r\n");
 		OS_EXIT_CRITICAL();
-		return NULL;	
+		return NULL;
 	}
-	
+
 	//ڴǷɹ
-	ptr = MallocMemory(size);
-	if(ptr == NULL || (u8*)ptr <= s_OSMemoryDev.memoryBase || (u8*)ptr >= s_OSMemoryDev.memoryEnd)
+	ptr = MemPlace(size, attr);
+	if(ptr == NULL)
 	{
+		s_OSMemoryDev.failCnt++;
 		printf("ERROR: [OSMalloc]: Fail To Malloc!\r\n");
 		OS_EXIT_CRITICAL();
 		return NULL;
@@ -239,25 +1246,66 @@ void* OSMalloc(u32 size)
 	return ptr;
 }
 
+/*********************************************************************************************************
+* : OSMallocFrom
+* : ָڴ
+* : p_regionڴ NULL ʾڲڴأsizeڴСֽڣ
+* : void
+*   ֵ: 䵽ڴ׵ַ û㹻ĿпʱNULL
+* : 20260222
+* ע    : ֻڸз ˵ ڰȵ㻺̶ CCM ȿڴ
+*********************************************************************************************************/
+void* OSMallocFrom(OS_MEM_REGION *p_region, u32 size)
+{
+	void* ptr;
+
+	if(p_region == NULL)
+	{
+		p_region = &s_OSMemoryRegion;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(size == 0 || size > OS_MEM_SIZE_MASK || p_region->memoryList == NULL)
+	{
+		printf("ERROR: [OSMallocFrom] Illegal Argument!\r\n");
+		OS_EXIT_CRITICAL();
+		return NULL;
+	}
+
+	ptr = MemRegionMalloc(p_region, size);
+	if(ptr == NULL)
+	{
+		p_region->failCnt++;
+		s_OSMemoryDev.failCnt++;
+		printf("ERROR: [OSMallocFrom]: Fail To Malloc From %s!\r\n", p_region->name);
+	}
+
+	OS_EXIT_CRITICAL();
+	return ptr;
+}
+
 /*********************************************************************************************************
 * : OSFree
 * : ڴͷ
-* : memxڴ飻ptrڴ׵ַ 
+* : ptrڴ׵ַ
 * : void
 *   ֵ: void
 * : 20260115
-* ע    : 
+* ע    :
 *           1) ͷźݲ㣬ռñ־λ
 *           2) ͷź᳢ڿпϲԼƬ
 *              - ϲ
 *              - ǰϲ
-*           3) ptr ǺϷַܵƻǰδϸУ飩
+*           3) ֻ ptr ǷĳڡǷռ״̬(ظͷ)
+*              ͷԽдʱ޷  OSMemCheck 
+*           4) ĸӿڷ ַҵͷ
 *********************************************************************************************************/
 void OSFree(void* ptr)
 {
-  OS_MEM_NODE* currNode;
-	OS_MEM_NODE* nextNode;
-	OS_MEM_NODE* prevNode;
+	OS_MEM_REGION *p_region;
+	OS_MEM_NODE *node;
+	u32 bytes;
 
 	OS_ENTER_CRITICAL();
 
@@ -267,33 +1315,154 @@ void OSFree(void* ptr)
 		OS_EXIT_CRITICAL();
     return;
   }
-  
-	//ɾǰ
-	currNode = (OS_MEM_NODE*)((u8*)ptr - OS_MEM_NODE_SIZE);	//õڴڴͷ
-	currNode->memUsedSize &= OS_MEM_SIZE_MASK;	//ڴռñ־
-	nextNode = currNode->memNextNode;
-	
-	//Ŀڴϲ
-	if(nextNode != NULL && (nextNode->memUsedSize & OS_MEM_USED_FLAG) == 0)	//滹ڴڴ
+
+	//ͷҶ Ϊռ״̬ҴСΪ0(TLSF ڱСΪ0)
+	node = (OS_MEM_NODE*)((u8*)ptr - OS_MEM_NODE_SIZE);
+	p_region = MemRegionFind(ptr);
+	if(p_region == NULL || (u8*)node < p_region->memoryBase ||
+	   ((u8*)node - p_region->memoryBase) % OS_MEM_ALIGN != 0 ||
+	   (node->memUsedSize & OS_MEM_USED_FLAG) == 0 || (node->memUsedSize & OS_MEM_SIZE_MASK) == 0)
 	{
-		currNode->memUsedSize = (currNode->memUsedSize & OS_MEM_SIZE_MASK) + (nextNode->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
-		currNode->memNextNode = nextNode->memNextNode;
+		printf("ERROR: [OSFree] Illegal pointer or double free!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
 	}
-	
-	//ǰĿڴϲ
-	prevNode = s_OSMemoryDev.memoryList;	//ȱҵǰڴ
-	while(prevNode != NULL && prevNode->memNextNode != currNode)
+
+	bytes = (node->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
+	FreeMemory(p_region, ptr);
+	p_region->freeBytes += bytes;
+	p_region->freeCnt++;
+	s_OSMemoryDev.freeBytes += bytes;
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* : OSMemStats
+* : ȡ()ʹƬͳ
+* : void
+* : p_statsͳϢ
+*   ֵ: void
+* : 20260223
+* ע    :
+*           (1) ڷ/ͷʱά ѯʱֻй  ʺϱ
+*           (2) largestFree Ϊп½е( MemLargestFree) freeMin Ϊֽ֮͵ʷСֵ
+*           (3) failCnt Ϊ OSMalloc/OSMallocAttr/OSMallocFrom ʧܴ
+*           (4) largestFree С freeBytes  fragNum  ˵ƬڼӾ
+*********************************************************************************************************/
+void OSMemStats(OS_MEM_STATS *p_stats)
+{
+	OS_MEM_REGION *p_region;
+	u32 largest;
+
+	if(p_stats == NULL)
 	{
-		prevNode = prevNode->memNextNode;
+		printf("ERROR: [OSMemStats] Illegal Argument!\r\n");
+		return;
 	}
-	if(prevNode != NULL && (prevNode->memUsedSize & OS_MEM_USED_FLAG) == 0)	//ǰ滹ڴڴ
+
+	OS_ENTER_CRITICAL();
+
+	memset(p_stats, 0, sizeof(OS_MEM_STATS));
+	for(p_region = s_OSMemoryDev.regionList; p_region != NULL; p_region = p_region->nextRegion)
 	{
-		prevNode->memUsedSize = (prevNode->memUsedSize & OS_MEM_SIZE_MASK) + (currNode->memUsedSize & OS_MEM_SIZE_MASK) + OS_MEM_NODE_SIZE;
-		prevNode->memNextNode = currNode->memNextNode;
+		largest = MemLargestFree(p_region);
+		if(largest > p_stats->largestFree)
+		{
+			p_stats->largestFree = largest;
+		}
+		p_stats->totalBytes += p_region->memoryEnd - p_region->memoryBase;
+		p_stats->fragNum    += p_region->fragNum;
+		p_stats->allocCnt   += p_region->allocCnt;
+		p_stats->freeCnt    += p_region->freeCnt;
 	}
-	
-	//if򲻺ϲ
+	p_stats->freeBytes = s_OSMemoryDev.freeBytes;
+	p_stats->freeMin   = s_OSMemoryDev.freeMin;
+	p_stats->failCnt   = s_OSMemoryDev.failCnt;
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* : OSMemRegionStats
+* : ȡָʹƬͳ
+* : p_regionڴ NULL ʾڲڴ
+* : p_statsͳϢ
+*   ֵ: void
+* : 20260223
+* ע    : failCnt ֻͳ OSMallocFrom ڸʧܵĴ(OSMalloc ʧʱ᳢Զ 뵥)
+*********************************************************************************************************/
+void OSMemRegionStats(OS_MEM_REGION *p_region, OS_MEM_STATS *p_stats)
+{
+	if(p_region == NULL)
+	{
+		p_region = &s_OSMemoryRegion;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(p_stats == NULL || p_region->memoryList == NULL)
+	{
+		OS_EXIT_CRITICAL();
+		printf("ERROR: [OSMemRegionStats] Illegal Argument!\r\n");
+		return;
+	}
+	MemStatsGet(p_region, p_stats);
+
+	OS_EXIT_CRITICAL();
+}
+
+#if OS_CFG_MEM_CHECK_EN != 0
+/*********************************************************************************************************
+* : OSMemCheck
+* : ˳ڴ ͷǰǷһ
+* : void
+* : void
+*   ֵ: 1-һ 0-(ӡһ)
+* : 20260221
+* ע    :
+*           (1) ÿͷҶ ǰһָһĿ
+*           (2) һڱ֮ һýĩβ(TLSF Ϊڱ)
+*           (3) ڵĿп(ͷʱӦѺϲ)
+*           (4) TLSF ʱҪеĿõĿпͬ Ҷǿп
+*           (5) άĿֽпһ
+*           (6) ȫ̹ж ʱ ڵ
+*********************************************************************************************************/
+u8 OSMemCheck(void)
+{
+	OS_MEM_REGION *p_region;
+	OS_MEM_NODE   *p_node;
+	const char    *p_err;
+
+	OS_ENTER_CRITICAL();
+
+	if(s_OSMemoryDev.memoryRdy == OS_MEM_NOT_READY)
+	{
+		OS_EXIT_CRITICAL();
+		printf("ERROR: MemoryPool Not Ready!\r\n");
+		return 0;
+	}
+
+	p_err  = NULL;
+	p_node = NULL;
+	for(p_region = s_OSMemoryDev.regionList; p_region != NULL; p_region = p_region->nextRegion)
+	{
+		p_err = MemRegionCheck(p_region, &p_node);
+		if(p_err != NULL)
+		{
+			break;
+		}
+	}
+
 	OS_EXIT_CRITICAL();
+
+	if(p_err != NULL)
+	{
+		printf("ERROR: [OSMemCheck] %s Block %p: %s!\r\n", p_region->name, (void*)p_node, p_err);
+		return 0;
+	}
+	return 1;
 }
+#endif	//OS_CFG_MEM_CHECK_EN
 
 #endif	//OS_CFG_MEM_EN
@@ -0,0 +1,313 @@
+/*********************************************************************************************************
+* ģƣos_mem_part.c
+* ժ    Ҫ̶ڴ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260220
+*     ݣ
+*           (1) ûṩĴ洢Ϊ N СͬĿ飬п鴮ɵȡ/黹ֻͷ
+*           (2) OSMemPartGet/OSMemPartPut жеãʺշС̶Ƶڴ
+*           (3) Ϊʱ OSMemPartGetTimeout ȴ黹ʱֱӰڴ齻ȼߵĵȴ
+*           (4) ÿͳƿпˮλɹȡʧܴ
+* ע    ⣺
+*           (1) ָڿпĵһУССһָ룬洢С谴ָ
+*           (2) ûпͷƬ黹ʱַֻǷڷλڿ߽磬ظ黹
+*           (3)  OSMalloc ޹أ洢Ǿ̬飬Ҳλκοɷʵ RAM 
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+#if OS_CFG_MEM_PART_EN != 0
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+extern OS_TASK_HANDLE* g_pCurrentTask;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void* OS_MemPartTake(OS_MEM_PART *p_part);	//ӿȡһ
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_MemPartTake
+* ܣӿͷȡһ鲢ͳ
+* p_part: ڴ
+* void
+*   ֵڴ׵ַ ΪʱNULL( failCnt)
+* ڣ20260220
+* ע    ⣺ٽڵ
+*********************************************************************************************************/
+static void* OS_MemPartTake(OS_MEM_PART *p_part)
+{
+	void *p_blk;
+
+	p_blk = p_part->freeList;
+	if(p_blk == NULL)
+	{
+		p_part->failCnt++;
+		return NULL;
+	}
+
+	p_part->freeList = *(void**)p_blk;
+	p_part->freeNum--;
+	if(p_part->freeNum < p_part->freeMin)
+	{
+		p_part->freeMin = p_part->freeNum;
+	}
+	p_part->getCnt++;
+	return p_blk;
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOSMemPartCreate
+* ܣڴ
+* p_part: ڴ p_name:  p_addr: 洢׵ַ blockNum:  blockSize: С(ֽ)
+* void
+*   ֵ1-ɹ 0-
+* ڣ20260220
+* ע    ⣺
+*           (1) 洢 blockNum * blockSize ֽ ɵ֤߱
+*           (2) blockSize СһָΪָС p_addr ָ
+*********************************************************************************************************/
+u8 OSMemPartCreate(OS_MEM_PART *p_part, u8 *p_name, void *p_addr, u32 blockNum, u32 blockSize)
+{
+	u8 *p_blk;
+	u32 i;
+
+	if(p_part == NULL || p_addr == NULL || blockNum == 0)
+	{
+		printf("ERROR:[OSMemPartCreate] Illegal argument!\r\n");
+		return 0;
+	}
+	if(blockSize < sizeof(void*) || (blockSize % sizeof(void*)) != 0 || ((u32)(size_t)p_addr % sizeof(void*)) != 0)
+	{
+		printf("ERROR:[OSMemPartCreate] Block size or address is not aligned!\r\n");
+		return 0;
+	}
+
+	//һ鿪ʼͷ ַ
+	p_blk = (u8*)p_addr + (blockNum - 1) * blockSize;
+	*(void**)p_blk = NULL;
+	for(i = 1; i < blockNum; i++)
+	{
+		*(void**)(p_blk - blockSize) = p_blk;
+		p_blk -= blockSize;
+	}
+
+	OS_ENTER_CRITICAL();
+	p_part->objType   = OS_OBJ_TYPE_MEM_PART;
+	OS_PendListInit(&p_part->pendList);
+	p_part->name      = p_name;
+	p_part->addr      = (u8*)p_addr;
+	p_part->freeList  = p_addr;
+	p_part->blockSize = blockSize;
+	p_part->blockNum  = blockNum;
+	p_part->freeNum   = blockNum;
+	p_part->freeMin   = blockNum;
+	p_part->getCnt    = 0;
+	p_part->failCnt   = 0;
+	OS_EXIT_CRITICAL();
+
+	return 1;
+}
+
+/*********************************************************************************************************
+* ƣOSMemPartGet
+* ܣڴȡһڴ
+* p_part: ڴ
+* void
+*   ֵڴ׵ַ ΪʱNULL
+* ڣ20260220
+* ע    ⣺
+*           (1) жϺоɵ 
+*           (2) ΪʱӡϢ ֻ failCnt жִкʱ
+*********************************************************************************************************/
+void* OSMemPartGet(OS_MEM_PART *p_part)
+{
+	void *p_blk;
+
+	if(p_part == NULL || p_part->objType != OS_OBJ_TYPE_MEM_PART)
+	{
+		printf("ERROR:[OSMemPartGet] Illegal argument!\r\n");
+		return NULL;
+	}
+
+	OS_ENTER_CRITICAL();
+	OS_TRACE(OS_TRACE_MEM_GET, p_part, p_part->freeList == NULL);
+	p_blk = OS_MemPartTake(p_part);
+	OS_EXIT_CRITICAL();
+
+	return p_blk;
+}
+
+/*********************************************************************************************************
+* ƣOSMemPartGetTimeout
+* ܣڴȡһڴ Ϊʱȴ
+* p_part: ڴ timeout: ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* void
+*   ֵڴ׵ַ ȴʱʱNULL
+* ڣ20260220
+* ע    ⣺
+*           (1) ֻе ڼΪʱNULL
+*           (2) ȴڼ黹ڴ OSMemPartPut ֱӽȼߵĵȴ 
+*           (3) ȴʱ failCnt
+*********************************************************************************************************/
+void* OSMemPartGetTimeout(OS_MEM_PART *p_part, u32 timeout)
+{
+	void *p_blk;
+
+	if(p_part == NULL || p_part->objType != OS_OBJ_TYPE_MEM_PART)
+	{
+		printf("ERROR:[OSMemPartGetTimeout] Illegal argument!\r\n");
+		return NULL;
+	}
+	if(OS_InISR())
+	{
+		printf("ERROR:[OSMemPartGetTimeout] Can not pend in ISR!\r\n");
+		return NULL;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	OS_TRACE(OS_TRACE_MEM_GET, p_part, p_part->freeList == NULL);
+	if(p_part->freeList != NULL)
+	{
+		p_blk = OS_MemPartTake(p_part);
+		OS_EXIT_CRITICAL();
+		return p_blk;
+	}
+	if(OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSMemPartGetTimeout] Scheduler is locked!\r\n");
+		p_part->failCnt++;
+		OS_EXIT_CRITICAL();
+		return NULL;
+	}
+
+	g_pCurrentTask->memPartBlk = NULL;
+	OS_PendTaskBlock(&p_part->pendList, (void*)p_part, timeout);
+
+	OS_EXIT_CRITICAL();
+	OS_Sched();
+	OS_ENTER_CRITICAL();
+
+	// OSMemPartPut ѻȴʱص
+	p_blk = g_pCurrentTask->memPartBlk;
+	if(p_blk == NULL)
+	{
+		p_part->failCnt++;
+	}
+	g_pCurrentTask->memPartBlk = NULL;
+
+	OS_EXIT_CRITICAL();
+	return p_blk;
+}
+
+/*********************************************************************************************************
+* ƣOSMemPartPut
+* ܣڴ黹ڴ
+* p_part: ڴ p_blk: ڴ׵ַ
+* void
+*   ֵvoid
+* ڣ20260220
+* ע    ⣺
+*           (1) жϺоɵ
+*           (2) ڵȴʱֱӽȼߵĵȴ п
+*           (3) ַڷڡڿ߽ϻ(ظ黹)ʱ
+*********************************************************************************************************/
+void OSMemPartPut(OS_MEM_PART *p_part, void *p_blk)
+{
+	OS_TASK_HANDLE *p_tcb;
+	u32 offset;
+
+	if(p_part == NULL || p_part->objType != OS_OBJ_TYPE_MEM_PART || p_blk == NULL)
+	{
+		printf("ERROR:[OSMemPartPut] Illegal argument!\r\n");
+		return;
+	}
+	offset = (u32)((u8*)p_blk - p_part->addr);
+	if((u8*)p_blk < p_part->addr || offset >= p_part->blockNum * p_part->blockSize || (offset % p_part->blockSize) != 0)
+	{
+		printf("ERROR:[OSMemPartPut] Block %p does not belong to %s!\r\n", p_blk, p_part->name);
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	p_tcb = OS_PendListGetHighest(&p_part->pendList);
+	OS_TRACE(OS_TRACE_MEM_PUT, p_part, p_tcb != NULL);
+	if(p_tcb != NULL)	//ڵȴ ֱӽȼߵ
+	{
+		p_tcb->memPartBlk = p_blk;
+		p_part->getCnt++;
+		OS_PendListRemove(&p_part->pendList, p_tcb);
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
+		OS_EXIT_CRITICAL();
+		OS_Sched();
+		return;
+	}
+
+	if(p_part->freeNum >= p_part->blockNum)
+	{
+		OS_EXIT_CRITICAL();
+		printf("ERROR:[OSMemPartPut] %s is full!\r\n", p_part->name);
+		return;
+	}
+	*(void**)p_blk = p_part->freeList;
+	p_part->freeList = p_blk;
+	p_part->freeNum++;
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSMemPartStatsGet
+* ܣȡڴʹͳ
+* p_part: ڴ p_stats: ַ
+* p_stats: ͳϢ
+*   ֵvoid
+* ڣ20260220
+* ע    ⣺usedMax ɿпˮλ ʾͬʱռõ
+*********************************************************************************************************/
+void OSMemPartStatsGet(OS_MEM_PART *p_part, OS_MEM_PART_STATS *p_stats)
+{
+	if(p_part == NULL || p_part->objType != OS_OBJ_TYPE_MEM_PART || p_stats == NULL)
+	{
+		printf("ERROR:[OSMemPartStatsGet] Illegal argument!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+	p_stats->blockSize = p_part->blockSize;
+	p_stats->blockNum  = p_part->blockNum;
+	p_stats->freeNum   = p_part->freeNum;
+	p_stats->usedMax   = p_part->blockNum - p_part->freeMin;
+	p_stats->getCnt    = p_part->getCnt;
+	p_stats->failCnt   = p_part->failCnt;
+	OS_EXIT_CRITICAL();
+}
+
+#endif	//OS_CFG_MEM_PART_EN
@@ -30,9 +30,14 @@
 *              -  Post ¸ȼʱ˳ٽ OS_Sched()
 *              - Pend µǰ OS_Sched() л
 *
-*           (7) ƣ
-*              - TODO: ǰʵδȼ̳УPriority Inheritance
-*                ȼȴȼе mutexܷȼת
+*           (7) ȼ̳УOS_CFG_MUTEX_PI_EN
+*              - Pend ʱ owner ĵǰȼȴߵȼ
+*              -  owner Ҳڵȴһ mutex"ȴ->owner"ݼ̳У
+*              - ÿάԼе mutex Post ʱ
+*                min(basePriority, Գеĸ mutex ߵȴȼ) ָȼ
+*
+*           (8) OS_MUTEX_HELD_EN
+*              - ȼ̳л OS_CFG_TASK_DEL_EN ʱά OSTaskDelete ݴ˾ܾɾԳ mutex 
 **********************************************************************************************************
 * ȡ汾
 *     ߣ
@@ -59,6 +64,13 @@ extern OS_TASK_HANDLE *g_pCurrentTask;
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
+#if OS_MUTEX_HELD_EN != 0
+static void OS_MutexHeldAdd(OS_TASK_HANDLE *p_tcb, OS_MUTEX *p_mutex);		//еĻ
+static void OS_MutexHeldRemove(OS_TASK_HANDLE *p_tcb, OS_MUTEX *p_mutex);	//ƳеĻ
+#endif
+#if OS_CFG_MUTEX_PI_EN != 0
+static void OS_MutexPrioInherit(OS_MUTEX *p_mutex, u32 prio);							//سȼ
+#endif
 
 /*********************************************************************************************************
 *                                              öٽṹ
@@ -67,20 +79,174 @@ extern OS_TASK_HANDLE *g_pCurrentTask;
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+#if OS_MUTEX_HELD_EN != 0
 /*********************************************************************************************************
-* ƣ
-* ܣ
-* void
+* ƣOS_MutexHeldAdd
+* ܣеĻ
+* p_tcb:  p_mutex: ָ
 * void
 *   ֵvoid
-* ڣ
+* ڣ20260207
+* ע    ⣺ٽڵ ͷ巨
+*********************************************************************************************************/
+static void OS_MutexHeldAdd(OS_TASK_HANDLE *p_tcb, OS_MUTEX *p_mutex)
+{
+	p_mutex->heldNextPtr = p_tcb->mutexHeldPtr;
+	p_tcb->mutexHeldPtr = p_mutex;
+}
+
+/*********************************************************************************************************
+* ƣOS_MutexHeldRemove
+* ܣƳеĻ
+* p_tcb:  p_mutex: ָ
+* void
+*   ֵvoid
+* ڣ20260207
+* ע    ⣺ٽڵ ȼͬʱеĻ ͨܶ
+*********************************************************************************************************/
+static void OS_MutexHeldRemove(OS_TASK_HANDLE *p_tcb, OS_MUTEX *p_mutex)
+{
+	OS_MUTEX **pp_mutex;
+
+	pp_mutex = &p_tcb->mutexHeldPtr;
+	while(*pp_mutex != NULL)
+	{
+		if(*pp_mutex == p_mutex)
+		{
+			*pp_mutex = p_mutex->heldNextPtr;
+			p_mutex->heldNextPtr = NULL;
+			return;
+		}
+		pp_mutex = &(*pp_mutex)->heldNextPtr;
+	}
+}
+#endif	//OS_MUTEX_HELD_EN
+
+#if OS_CFG_MUTEX_PI_EN != 0
+/*********************************************************************************************************
+* ƣOS_MutexPrioInherit
+* ܣ owner ȼ prio  owner Ҳڵȴ
+* p_mutex: ָ prio: ȴȼ
+* void
+*   ֵvoid
+* ڣ20260207
 * ע    ⣺
+*           (1) ٽڵ
+*           (2) ֻ ȼѲ prio ֹͣ ɻʱҲܽ
 *********************************************************************************************************/
+static void OS_MutexPrioInherit(OS_MUTEX *p_mutex, u32 prio)
+{
+	OS_TASK_HANDLE *p_owner;
+
+	p_owner = p_mutex->ownerTcb;
+	while(p_owner != NULL && p_owner->priority > prio)
+	{
+		OS_TaskPrioSet(p_owner, prio);
+
+		//owner ûڵȴ ݽ
+		if(p_owner->state != OS_TASK_PEND || p_owner->pendObj == NULL || *(OS_OBJ_TYPE*)p_owner->pendObj != OS_OBJ_TYPE_MUTEX)
+		{
+			break;
+		}
+		p_owner = ((OS_MUTEX*)p_owner->pendObj)->ownerTcb;
+	}
+}
+#endif	//OS_CFG_MUTEX_PI_EN
 
 
 /*********************************************************************************************************
 *                                              APIʵ
 *********************************************************************************************************/
+#if OS_CFG_MUTEX_PI_EN != 0
+/*********************************************************************************************************
+* ƣOS_MutexPrioCalc
+* ܣӦеȼ
+* p_tcb: 
+* void
+*   ֵbasePriority еĸߵȴȼе
+* ڣ20260207
+* ע    ⣺û ٽڵ бȼ ͷ㼴ȼȴ
+*********************************************************************************************************/
+u32 OS_MutexPrioCalc(OS_TASK_HANDLE *p_tcb)
+{
+	OS_MUTEX *p_mutex;
+	u32 prio;
+
+	prio = p_tcb->basePriority;
+	p_mutex = p_tcb->mutexHeldPtr;
+	while(p_mutex != NULL)
+	{
+		if(p_mutex->pendList.headPtr != NULL && p_mutex->pendList.headPtr->priority < prio)
+		{
+			prio = p_mutex->pendList.headPtr->priority;
+		}
+		p_mutex = p_mutex->heldNextPtr;
+	}
+
+	return prio;
+}
+
+/*********************************************************************************************************
+* ƣOS_MutexPrioRestore
+* ܣȴ뿪бȼͺ س¼ owner ȼ
+* p_mutex: ȴڵĻ
+* void
+*   ֵvoid
+* ڣ20260208
+* ע    ⣺
+*           (1) û ٽڵ ɵȴʱ(OS_TickUpdate)ɾȴ(OSTaskDelete)
+*               뽵͵ȴȼ(OS_MutexPendPrioChange)
+*           (2) owner Ҳڵȴʱ "ȴ->owner" ȼ owner ֹͣ
+*********************************************************************************************************/
+void OS_MutexPrioRestore(OS_MUTEX *p_mutex)
+{
+	OS_TASK_HANDLE *p_owner;
+	u32 prio;
+
+	p_owner = p_mutex->ownerTcb;
+	while(p_owner != NULL)
+	{
+		prio = OS_MutexPrioCalc(p_owner);
+		if(prio == p_owner->priority)
+		{
+			break;
+		}
+		OS_TaskPrioSet(p_owner, prio);
+
+		//owner ûڵȴ ݽ
+		if(p_owner->state != OS_TASK_PEND || p_owner->pendObj == NULL || *(OS_OBJ_TYPE*)p_owner->pendObj != OS_OBJ_TYPE_MUTEX)
+		{
+			break;
+		}
+		p_owner = ((OS_MUTEX*)p_owner->pendObj)->ownerTcb;
+	}
+}
+
+/*********************************************************************************************************
+* ƣOS_MutexPendPrioChange
+* ܣȴߵȼ޸ĺ  owner ļ̳ȼ
+* p_mutex: ȴڵȴĻ prioOld: ȴԭȼ prioNew: ȴȼ
+* void
+*   ֵvoid
+* ڣ20260218
+* ע    ⣺
+*           (1) û  OSTaskChangePrio ڵȴѰȼ²б ٽڵ
+*           (2) ʱس
+*           (3) ʱ OS_MutexPrioRestore س¼ owner ȼ
+*********************************************************************************************************/
+void OS_MutexPendPrioChange(OS_MUTEX *p_mutex, u32 prioOld, u32 prioNew)
+{
+	if(prioNew < prioOld)
+	{
+		OS_MutexPrioInherit(p_mutex, prioNew);
+	}
+	else
+	{
+		OS_MutexPrioRestore(p_mutex);
+	}
+}
+#endif	//OS_CFG_MUTEX_PI_EN
+
 /*********************************************************************************************************
 * ƣOSMutexCreate
 * ܣ
@@ -101,6 +267,9 @@ void OSMutexCreate(OS_MUTEX *p_mutex, u8* p_name)
 	p_mutex->name = p_name;
 	p_mutex->ownerTcb = NULL;
 	p_mutex->lockCnt = 0;
+#if OS_MUTEX_HELD_EN != 0
+	p_mutex->heldNextPtr = NULL;
+#endif
 }
 
 /*********************************************************************************************************
@@ -123,11 +292,16 @@ void OSMutexCreate(OS_MUTEX *p_mutex, u8* p_name)
 *                ͬʱ lockCnt Ϊ 1
 *
 *           (4) ͷŵ¸ȼ˳ٽ OS_Sched()
+*
+*           (5) ȼ̳Уͷʱǰָ basePriority ԳлߵȴȼеĽϸ
 *********************************************************************************************************/
 void OSMutexPost(OS_MUTEX *p_mutex)
 {
 	OS_TASK_HANDLE *p_tcb;
 	OS_PEND_LIST *p_pend_list;
+#if OS_CFG_MUTEX_PI_EN != 0
+	u32 prio;
+#endif
 	
 	OS_ENTER_CRITICAL();
 	
@@ -135,6 +309,7 @@ void OSMutexPost(OS_MUTEX *p_mutex)
 	if(p_mutex == NULL || p_mutex->objType != OS_OBJ_TYPE_MUTEX)
 	{
 		printf("ERROR:[OSMutexPost] Illegal argument!\r\n");
+		OS_EXIT_CRITICAL();
 		return;
 	}
 	
@@ -161,6 +336,19 @@ void OSMutexPost(OS_MUTEX *p_mutex)
 
 	//ͷ/תȨ
 	p_pend_list = &p_mutex->pendList;
+	OS_TRACE(OS_TRACE_MUTEX_POST, p_mutex, p_pend_list->headPtr != NULL);
+
+#if OS_MUTEX_HELD_EN != 0
+	OS_MutexHeldRemove(g_pCurrentTask, p_mutex);
+#endif
+#if OS_CFG_MUTEX_PI_EN != 0
+	//û̳еȼ
+	prio = OS_MutexPrioCalc(g_pCurrentTask);
+	if(prio != g_pCurrentTask->priority)
+	{
+		OS_TaskPrioSet(g_pCurrentTask, prio);
+	}
+#endif
 
 	if(p_pend_list->headPtr == NULL)
 	{
@@ -168,6 +356,9 @@ void OSMutexPost(OS_MUTEX *p_mutex)
 		p_mutex->ownerTcb = NULL;
 		//lockCnt Ѿ 0
 		OS_EXIT_CRITICAL();
+#if OS_CFG_MUTEX_PI_EN != 0
+		OS_Sched();	//ȼѽ
+#endif
 		return;
 	}
 	else
@@ -175,13 +366,13 @@ void OSMutexPost(OS_MUTEX *p_mutex)
 		//еȴߣתƸȼ
 		p_tcb = OS_PendListGetHighest(p_pend_list);
 		OS_PendListRemove(p_pend_list, p_tcb);
-
-		p_tcb->state   = OS_TASK_READY;
-		p_tcb->pendObj = NULL;
-		OS_RdyTaskAdd(p_tcb);
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
 
 		p_mutex->ownerTcb = p_tcb;
 		p_mutex->lockCnt  = 1;   // owner һ
+#if OS_MUTEX_HELD_EN != 0
+		OS_MutexHeldAdd(p_tcb, p_mutex);
+#endif
 
 		OS_EXIT_CRITICAL();
 		OS_Sched();
@@ -209,10 +400,25 @@ void OSMutexPost(OS_MUTEX *p_mutex)
 *              -  mutex  pendList
 *              - state=OS_TASK_PENDpendObj ָ mutex
 *              -  OS_Sched() л
+*              - ȼ̳Уowner ȼڵǰʱ ownerȴϵ owner
 *
-*           (4) TODO: ʵֲֳ֧ʱȴ賬ʱ Tick չ
+*           (4) õȴ ȼ OSMutexPendTimeout(p_mutex, OS_WAIT_FOREVER)
 *********************************************************************************************************/
 void OSMutexPend(OS_MUTEX *p_mutex)
+{
+	OSMutexPendTimeout(p_mutex, OS_WAIT_FOREVER);
+}
+
+/*********************************************************************************************************
+* ƣOSMutexPendTimeout
+* ܣʱȴ
+* p_mutex: ָ timeout: ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* void
+*   ֵOS_PEND_OK: û OS_PEND_TIMEOUT: ȴʱ OS_PEND_ERR: 
+* ڣ20260208
+* ע    ⣺ʱ ϸ owner ̳еȼ OS_MutexPrioRestore 
+*********************************************************************************************************/
+OS_PEND_STAT OSMutexPendTimeout(OS_MUTEX *p_mutex, u32 timeout)
 {
 	OS_ENTER_CRITICAL();
 	
@@ -220,16 +426,22 @@ void OSMutexPend(OS_MUTEX *p_mutex)
 	if(p_mutex == NULL || p_mutex->objType != OS_OBJ_TYPE_MUTEX)
 	{
 		printf("ERROR:[OSMutexPend] Illegal argument!\r\n");
-		return;
+		OS_EXIT_CRITICAL();
+		return OS_PEND_ERR;
 	}
 	
+	OS_TRACE(OS_TRACE_MUTEX_PEND, p_mutex, p_mutex->ownerTcb != NULL && p_mutex->ownerTcb != g_pCurrentTask);
+	
 	//
 	if(p_mutex->ownerTcb == NULL && p_mutex->lockCnt == 0)
 	{
 		p_mutex->ownerTcb = g_pCurrentTask;
 		p_mutex->lockCnt = 1;	//һ
+#if OS_MUTEX_HELD_EN != 0
+		OS_MutexHeldAdd(g_pCurrentTask, p_mutex);
+#endif
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_OK;
 	}
 	
 	//ѾԼϹ(ݹ)
@@ -237,18 +449,28 @@ void OSMutexPend(OS_MUTEX *p_mutex)
 	{
 		p_mutex->lockCnt++;
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_OK;
 	}
 	
 	//
-	OS_RdyTaskRemove(g_pCurrentTask);
-	OS_PendListInsert(&p_mutex->pendList, g_pCurrentTask);
-	g_pCurrentTask->state = OS_TASK_PEND;
-	g_pCurrentTask->pendObj = (void*)p_mutex;
+	if(OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSMutexPend] Scheduler is locked!\r\n");
+		OS_EXIT_CRITICAL();
+		return OS_PEND_ERR;
+	}
+	OS_PendTaskBlock(&p_mutex->pendList, (void*)p_mutex, timeout);
+	
+#if OS_CFG_MUTEX_PI_EN != 0
+	OS_MutexPrioInherit(p_mutex, g_pCurrentTask->priority);
+#endif
 	
 	//
 	OS_EXIT_CRITICAL();
 	OS_Sched();
+	
+	// OSMutexPost תȨȴʱص
+	return g_pCurrentTask->pendStat;
 }
 
 #endif //OS_CFG_MUTEX_EN
@@ -0,0 +1,194 @@
+/*********************************************************************************************************
+* ģƣos_notify.c
+* ժ    Ҫ֪ͨ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260216
+*     ݣ
+*           (1) ÿ TCB Ƕһ32λֵ֪ͨͷ OS_NOTIFY_ACTION ޸ĺĿ
+*           (2) λ/һ//ֱֲԴ¼־顢źͳΪ1
+*           (3) ֻĿԼܵȴԼ֪ͨҪбҲҪ̬ڴ
+* ע    ⣺
+*           (1) ֪ͨṹ屾Ϊȴ(ڽϢͬ) ʱֱӻĿ񣬲б
+*           (2) OSTaskNotify жеãж֪ͨСķʽ
+*           (3) ֵֻ֪ͨһͷͬʱʹ OVERWRITE ʱֻµֵ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+#if OS_CFG_TASK_NOTIFY_EN != 0
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+extern OS_TASK_HANDLE* g_pCurrentTask;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_TaskNotifyInit
+* ܣʼ֪ͨ
+* p_tcb: 
+* void
+*   ֵvoid
+* ڣ20260216
+* ע    ⣺û  OSRegister  ʼֵ֪ͨΪ0ûδ֪ͨ
+*********************************************************************************************************/
+void OS_TaskNotifyInit(OS_TASK_HANDLE* p_tcb)
+{
+	p_tcb->notify.objType = OS_OBJ_TYPE_NOTIFY;
+	p_tcb->notify.value   = 0;
+	p_tcb->notify.pending = 0;
+}
+
+/*********************************************************************************************************
+* ƣOSTaskNotify
+* ܣ֪ͨ
+* p_tcb: Ŀ value: (INCREMENT ʱ) action: ֵ֪ͨĲ
+* void
+*   ֵ1-ɹ 0-ʧ(NO_OVERWRITE ʱδ֪ͨ )
+* ڣ20260216
+* ע    ⣺
+*           (1) жϺоɵ
+*           (2) Ŀڵȴ֪ͨʱֱתб
+*           (3) жеʱ Ŀ OSIntExit ʱõ
+*********************************************************************************************************/
+u8 OSTaskNotify(OS_TASK_HANDLE* p_tcb, u32 value, OS_NOTIFY_ACTION action)
+{
+	OS_TASK_NOTIFY *p_notify;
+	u8 wake;
+
+	if(p_tcb == NULL)
+	{
+		printf("ERROR:[OSTaskNotify] Illegal argument!\r\n");
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	p_notify = &p_tcb->notify;
+	switch(action)
+	{
+		case OS_NOTIFY_SET_BITS:
+			p_notify->value |= value;
+			break;
+		case OS_NOTIFY_INCREMENT:
+			p_notify->value++;
+			break;
+		case OS_NOTIFY_OVERWRITE:
+			p_notify->value = value;
+			break;
+		case OS_NOTIFY_NO_OVERWRITE:
+			if(p_notify->pending)	//һ֪ͨûбȡ
+			{
+				OS_EXIT_CRITICAL();
+				return 0;
+			}
+			p_notify->value = value;
+			break;
+		default:
+			OS_EXIT_CRITICAL();
+			printf("ERROR:[OSTaskNotify] Illegal action!\r\n");
+			return 0;
+	}
+	p_notify->pending = 1;
+
+	//Ŀڵȴ֪ͨ ֱӻ
+	wake = (p_tcb->state == OS_TASK_PEND && p_tcb->pendObj == (void*)p_notify);
+	OS_TRACE(OS_TRACE_NOTIFY_POST, p_notify, wake);
+	if(wake)
+	{
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
+	}
+
+	OS_EXIT_CRITICAL();
+
+	if(wake)
+	{
+		OS_Sched();
+	}
+	return 1;
+}
+
+/*********************************************************************************************************
+* ƣOSTaskNotifyWait
+* ܣǰȴ֪ͨ
+* clrOnEntry: ûδ֪ͨʱ ǰλ
+*           clrOnExit : ȡ֪ͨλ(0xFFFFFFFF ʾȡߺ)
+*           timeout   : ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* p_value:  clrOnExit ֮ǰֵ֪ͨ(ΪNULL) ʱʱ޸
+*   ֵOS_PEND_OK: յ֪ͨ OS_PEND_TIMEOUT: ȴʱ OS_PEND_ERR: 
+* ڣ20260216
+* ע    ⣺
+*           (1) ֻе δ֪ͨʱ
+*           (2) źʹʱ ͷ INCREMENT clrOnExit ȡ 0xFFFFFFFF ֵΪۼƵ֪ͨ
+*           (3) ѺǷδ֪ͨΪ׼ ʱ֪ͨͬʱʱյ֪ͨ
+*********************************************************************************************************/
+OS_PEND_STAT OSTaskNotifyWait(u32 clrOnEntry, u32 clrOnExit, u32 *p_value, u32 timeout)
+{
+	OS_TASK_NOTIFY *p_notify;
+
+	OS_ENTER_CRITICAL();
+
+	p_notify = &g_pCurrentTask->notify;
+	OS_TRACE(OS_TRACE_NOTIFY_PEND, p_notify, p_notify->pending == 0);
+	if(!p_notify->pending)
+	{
+		if(OS_SchedIsLocked())
+		{
+			printf("ERROR:[OSTaskNotifyWait] Scheduler is locked!\r\n");
+			OS_EXIT_CRITICAL();
+			return OS_PEND_ERR;
+		}
+
+		p_notify->value &= ~clrOnEntry;
+		OS_PendTaskBlock(NULL, (void*)p_notify, timeout);
+
+		OS_EXIT_CRITICAL();
+		OS_Sched();
+		OS_ENTER_CRITICAL();
+
+		if(!p_notify->pending)	//ʱ
+		{
+			OS_EXIT_CRITICAL();
+			return OS_PEND_TIMEOUT;
+		}
+	}
+
+	if(p_value != NULL)
+	{
+		*p_value = p_notify->value;
+	}
+	p_notify->value &= ~clrOnExit;
+	p_notify->pending = 0;
+
+	OS_EXIT_CRITICAL();
+	return OS_PEND_OK;
+}
+
+#endif	//OS_CFG_TASK_NOTIFY_EN
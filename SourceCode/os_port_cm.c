@@ -0,0 +1,452 @@
+/*********************************************************************************************************
+* ģƣos_port_cm.c
+* ժ    ҪCasyOS Cortex-M3/M4 ֲ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260131
+*     ݣ
+*           (1) 쳣ڣSVCһ/ PendSVл
+*           (2) ʼջ֡죨ģһ쳣ѹջֳ
+*           (3) SysTick á쳣ȼáٽʵ
+*           (4) tickless ߣװ SysTick Խĺ WFI
+*           (5) ʱͳʹ DWT ڼ CYCCNT
+* ע    ⣺
+*           (1) ļоƬںǿأֲںʱ滻ļ
+*               ˷ Linux_HostDemo/OS/os_port_posix.c
+*           (2) л PendSV 쳣ɣ״ SVC 쳣
+*           (3) PSPϣжPendSV/SVCʹöMSPжջ(Сļе Stack_Size )
+*               ջֻһ쳣ջ֡ΪжǶԤռ䣬MSPжǶ
+*           (4) ʹ OS_CFG_FPU_EN ʱʹӲѹջ(FPCCR.ASPEN/LSPEN)ֻùFPU(EXC_RETURN bit4=0)
+*               лʱ/ָ S16-S31ʹFPU񲻶ռջռ
+*               (͵ַߵַ)R4-R11EXC_RETURN[S16-S31]
+*           (5) ٽͨ BASEPRI ֻȼֵС OS_CFG_MAX_SYSCALL_PRIO жϣ
+*               ȼж(PWM)ںӰ죬κں˽ӿ
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#define PENDSV_TRIGGER (*(u32*)0xE000ED04 |= 0x10000000)	//PENDSV쳣 ̵
+#define OS_PORT_TICK_HZ 1000U																//ϵͳƵ(Hz)
+
+#if OS_CFG_MAX_SYSCALL_PRIO == 0 || OS_CFG_MAX_SYSCALL_PRIO >= (1 << OS_CFG_NVIC_PRIO_BITS)
+#error "OS_CFG_MAX_SYSCALL_PRIO must be in 1 ~ (2^OS_CFG_NVIC_PRIO_BITS - 1)"
+#endif
+
+#define OS_PORT_BASEPRI_SYSCALL (OS_CFG_MAX_SYSCALL_PRIO << (8 - OS_CFG_NVIC_PRIO_BITS))	//ٽдBASEPRIֵ(Ҳõ)
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static u32 s_OSCriticalNestCnt;	//ٽǶײ
+static u32 s_OSCriticalBasepri;	//ٽǰBASEPRI
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣSVC_Handler
+* ܣSVC_HandlerжϷ
+* void
+* void
+*   ֵvoid
+* ڣ20260131
+* ע    ⣺
+*           (1) úжãΪ static
+*           (2) Ҫϵͳ״ʱָһ
+*           (3) ʵ OS_UpdateCurrentTask() ѡȼ
+*           (4) main ٷأMSPλΪеĳʼֵջΪжջʹ
+*               ʹ OS_CFG_FPU_EN ʱ FPCCR.LSPACTmain ùFPUʱ SVC µĶѹջδ
+*                ֮һFPUָ S0-S15/FPSCR дΪжջõλ
+*           (5) һֳPSPջлָEXC_RETURN=0xFFFFFFFD غлPSP
+*********************************************************************************************************/
+__ASM void SVC_Handler(void)
+{
+	PRESERVE8                		//öʼַ8ֽڶ
+	IMPORT OS_UpdateCurrentTask //뺯OS_UpdateCurrentTask
+	IMPORT g_pCurrentTask    		//g_pCurrentTask
+
+	//οɵں˽ӿڵж
+	MOV R0, #OS_PORT_BASEPRI_SYSCALL
+	MSR BASEPRI, R0
+
+#if OS_CFG_FPU_EN != 0
+	// main ջ֡δɵĶѹջ
+	LDR R0,= 0xE000EF34      //FPU->FPCCR
+	LDR R1, [R0]
+	BIC R1, R1, #0x01        // LSPACT
+	STR R1, [R0]
+#endif
+
+	//λMSP һΪʼջ
+	LDR R0,= 0xE000ED08      //SCB->VTOR
+	LDR R0, [R0]
+	LDR R0, [R0]
+	MSR MSP, R0
+
+	//ȼߵ񣬸µg_pCurrentTask
+	BL OS_UpdateCurrentTask
+
+	//ȡһջָ(ṹһԱΪջָ)
+	LDR R4,= g_pCurrentTask  //ȡg_pCurrentTaskĵַ浽R4
+	LDR R5, [R4]             //ȡg_pCurrentTaskݣǰ׵ַ浽R5
+	LDR R0, [R5]             //ȡ׵ַ4ֽݣջ
+
+	//ָһԤֳ(ʼջ֡FPUĴ)
+	LDMIA R0!, {R4-R11, LR}  //ָR4-R11LR(EXC_RETURN)
+	MSR PSP, R0              //ʣµӲջ֡쳣ʱPSP
+
+	//ȡж
+	MOV R0, #0
+	MSR BASEPRI, R0
+
+	//쳣˳
+	BX LR
+	NOP
+}
+
+/*********************************************************************************************************
+* : PendSV_Handler
+* : PendSVжϷʵл
+* : void
+* : void
+*   ֵ: void
+* : 20260131
+* ע    :
+*           (1) PendSV_HandlerжãΪڲ
+*               MSPϣֳͨPSPдջ
+*           (2) PendSV ȼʺл
+*           (3) Cortex-M ӲԶ R0-R3R12LRPCxPSR𱣴Ĵ
+*           (4) ѡһٱֳ񲻱ʱֱӷأд R4-R11(S16-S31)
+*           (5) EXC_RETURN bit4=0 ʾʹùFPU Ӳջ֡Ϊչջ֡ Ҫ/ָ S16-S31
+*                S16-S31  VSTMDB ȴѹջ  S0-S15/FPSCR дӲջ֡Ԥλ
+*               OS_UpdateCurrentTask ѭ AAPCS ƻ R4-R11÷غЩĴǵǰֵ
+*********************************************************************************************************/
+__ASM void PendSV_Handler(void)
+{
+  PRESERVE8                			//öʼַ8ֽڶ
+  IMPORT OS_UpdateCurrentTask		//뺯OS_UpdateCurrentTask
+  IMPORT g_pCurrentTask    			//g_pCurrentTask
+
+  //οɵں˽ӿڵж ӳжԿռ
+  MOV R0, #OS_PORT_BASEPRI_SYSCALL
+  MSR BASEPRI, R0
+
+  //µǰ ʱͲȼߵ
+  LDR R0,= g_pCurrentTask  //ȡg_pCurrentTaskĵַ浽R0
+  LDR R1, [R0]             //ȡg_pCurrentTaskݣǰ׵ַ浽R1
+  PUSH{R1, LR}             //浱ǰLR ֱջ8ֽڶ
+  BL OS_UpdateCurrentTask
+  POP{R1, LR}
+
+  //񲻱 ֱӷ
+  LDR R0,= g_pCurrentTask
+  LDR R2, [R0]             //R2Ϊһ׵ַ
+  CMP R1, R2
+  BEQ PendSV_Exit
+
+  //浱ǰֳݵPSPջ(xPSRPCLRR12ԼR3~R0ѾԶ)
+  MRS R0, PSP
+#if OS_CFG_FPU_EN != 0
+  TST LR, #0x10            //EXC_RETURN bit4=0 ǰʹùFPU
+  IT EQ
+  VSTMDBEQ R0!, {S16-S31}  //S16-S31
+#endif
+  STMDB R0!, {R4-R11, LR}  //R4-R11LR(EXC_RETURN)
+
+  //浱ǰջָ(ṹһԱΪջָ)
+  STR R0, [R1]             //ָ밴ֱ浽ʼλãOS_TASK_HANDLEṹһԱ
+
+  //ָһջָ(ṹһԱΪջָ)
+  LDR R0, [R2]             //ȡ׵ַ4ֽ
+
+  //ָһֳ
+  LDMIA R0!, {R4-R11, LR}  //ָR4-R11LR(EXC_RETURN)
+#if OS_CFG_FPU_EN != 0
+  TST LR, #0x10            //һʹùFPU
+  IT EQ
+  VLDMIAEQ R0!, {S16-S31}  //ָS16-S31
+#endif
+  MSR PSP, R0              //ʣµӲջ֡쳣ʱPSP
+
+PendSV_Exit
+  //ȡж(PendSVΪȼ ռһٽ)
+  MOV R0, #0
+  MSR BASEPRI, R0
+
+  //쳣˳
+  BX LR
+}
+
+/*********************************************************************************************************
+* ƣOS_PortStkInit
+* ܣʼջ֡
+* p_tcb: ƿָ루stackBase/stackSize/func д
+* p_tcb->stackTop: ʼջ֡ջ
+*   ֵvoid
+* ڣ20260131
+* ע    ⣺
+*           (1) ջ֡ PendSV_Handler/SVC_Handler ĳջ˳ϸһ
+*           (2) ջ8ֽڶ
+*           (3) û  OSRegister ʹ
+*           (4) δʹFPU ʼջ֡Ϊջ֡ Ԥ S16-S31
+*           (5)  return ʱת OS_TaskReturn ɾ ַѴ Thumb λ
+*********************************************************************************************************/
+void OS_PortStkInit(OS_TASK_HANDLE* p_tcb)
+{
+  u32* top; //ջַ
+
+	//ȡջ8ֽڶ
+	top = (u32*)(p_tcb->stackBase + p_tcb->stackSize);
+	top = (u32*)((u32)top & ~0x07);
+
+	/*--------ӲԶָ--------*/
+	*(--top) = 0x01000000;          //xPSR
+	*(--top) = (u32)p_tcb->func;    //PC
+	*(--top) = (u32)OS_TaskReturn;  //LR غں
+	*(--top) = 0x12121212;          //R12
+	*(--top) = 0x03030303;          //R3
+	*(--top) = 0x02020202;          //R2
+	*(--top) = 0x01010101;          //R1
+	*(--top) = 0x00000000;          //R0
+
+	/*-------------------*/
+	*(--top) = 0xFFFFFFFDUL;        //EXC_RETURN ߳ģʽʹPSP ջ֡
+	*(--top) = 0x11111111;          //R11
+	*(--top) = 0x10101010;          //R10
+	*(--top) = 0x09090909;          //R9
+	*(--top) = 0x08080808;          //R8
+	*(--top) = 0x07070707;          //R7
+	*(--top) = 0x06060606;          //R6
+	*(--top) = 0x05050505;          //R5
+	*(--top) = 0x04040404;          //R4
+
+	p_tcb->stackTop = top;
+}
+
+/*********************************************************************************************************
+* ƣOS_PortStartFirstTask
+* ܣϵͳ쳣ȼһ
+* void
+* void
+*   ֵvoidأ
+* ڣ20260131
+* ע    ⣺޸ϵͳʱƵ
+*********************************************************************************************************/
+void OS_PortStartFirstTask(void)
+{
+  SCB->CCR |= SCB_CCR_STKALIGN_Msk;        //ʹ˫ջ
+  SysTick_Config(SystemCoreClock / OS_PORT_TICK_HZ); //ϵͳδʱ1msжһ
+  NVIC_SetPriority(SysTick_IRQn, OS_CFG_MAX_SYSCALL_PRIO); //SysTickΪɵں˽ӿڵȼ ᱻںжϴ
+  NVIC_SetPriority(SVCall_IRQn, 0x01U);    //SVCȼ
+  NVIC_SetPriority(PendSV_IRQn, 0xFFU);    //PendSVȼСȼ
+#if OS_CFG_FPU_EN != 0
+  FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;	//ʹFPUֳԶͶѹջ(λĬʹ)
+#endif
+#if OS_PORT_TIMESTAMP_EN != 0
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;	//ʹDWT
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;            //ڼ Ϊʱͳ/¼׷/Ӻṩʱ
+#endif
+  __ASM("SVC #0x03");                      //һ
+}
+
+/*********************************************************************************************************
+* ƣOS_PortPendSVTrigger
+* ܣPendSV쳣 һл
+* void
+* void
+*   ֵvoid
+* ڣ20260131
+* ע    ⣺û  OS_Sched/OSIntExit/OSDelay 
+*********************************************************************************************************/
+void OS_PortPendSVTrigger(void)
+{
+	PENDSV_TRIGGER;
+}
+
+/*********************************************************************************************************
+* ƣOS_ENTER_CRITICAL
+* ܣٽ
+* void
+* void
+*   ֵvoid
+* ڣ20260131
+* ע    ⣺
+*           (1) ֧Ƕ ʱԭBASEPRI  OS_EXIT_CRITICAL ָ
+*           (2) ֻȼֵС OS_CFG_MAX_SYSCALL_PRIO ж
+*           (3) ޸Ƕײ ɵں˽ӿڵжϲῴм״̬
+*********************************************************************************************************/
+void OS_ENTER_CRITICAL(void)
+{
+	u32 basepri;
+
+	basepri = __get_BASEPRI();
+	__set_BASEPRI_MAX(OS_PORT_BASEPRI_SYSCALL);	//ֻμ
+	__DSB();
+	__ISB();
+
+	if(s_OSCriticalNestCnt == 0)
+	{
+		s_OSCriticalBasepri = basepri;
+	}
+	s_OSCriticalNestCnt++;
+}
+
+/*********************************************************************************************************
+* ƣOS_EXIT_CRITICAL
+* ܣ˳ٽ
+* void
+* void
+*   ֵvoid
+* ڣ20260131
+* ע    ⣺ֻ˳ʱŻָǰBASEPRI ڲ˳ǰж
+*********************************************************************************************************/
+void OS_EXIT_CRITICAL(void)
+{
+	if(s_OSCriticalNestCnt == 0)
+	{
+		printf("ERROR:[OS_EXIT_CRITICAL] Not in critical section!\r\n");
+		return;
+	}
+
+	s_OSCriticalNestCnt--;
+	if(s_OSCriticalNestCnt == 0)
+	{
+		__set_BASEPRI(s_OSCriticalBasepri);
+	}
+}
+
+#if OS_PORT_TIMESTAMP_EN != 0
+/*********************************************************************************************************
+* ƣOS_PortTimestampGet
+* ܣȡʱ
+* void
+* void
+*   ֵDWT CYCCNT ǰֵ
+* ڣ20260211
+* ע    ⣺ںʱӼ 120MHz Լ35sһ WFI ڼ
+*********************************************************************************************************/
+u32 OS_PortTimestampGet(void)
+{
+	return DWT->CYCCNT;
+}
+
+/*********************************************************************************************************
+* ƣOS_PortTimestampFreq
+* ܣȡʱƵ
+* void
+* void
+*   ֵںʱƵ(Hz)
+* ڣ20260211
+* ע    ⣺
+*********************************************************************************************************/
+u32 OS_PortTimestampFreq(void)
+{
+	return SystemCoreClock;
+}
+#endif	//OS_PORT_TIMESTAMP_EN
+
+#if OS_CFG_TICKLESS_EN != 0
+/*********************************************************************************************************
+* ƣOS_PortTicklessSleep
+* ܣͣڽ һSysTickԽticksĺWFI
+* ticks: ߵĽ(>=2) SysTick 24λΧʱԶض
+* void
+*   ֵҪں˲ǵ
+* ڣ20260205
+* ע    ⣺
+*           (1) ٽڵ BASEPRIεж޷WFI ڼʱPRIMASK
+*               жԿɽں˴WFI Ҫ˳ٽִ
+*           (2) ˯ʱ SysTick жѹ 䲹һ ֻ ticks-1
+*           (3) жǰʱѼ SysTickװһı߽
+*           (4) ڼֹͣļڲ л
+*********************************************************************************************************/
+u32 OS_PortTicklessSleep(u32 ticks)
+{
+	u32 cyclesPerTick;	//ÿĵSysTickֵ
+	u32 maxTicks;				//SysTick 24λܿԽ
+	u32 reload;					//ߵװֵ
+	u32 ctrl;						//SysTick->CTRL(COUNTFLAG ֻһ)
+	u32 elapsedCycles;	//ǰһı߽Ѽ
+	u32 sleptTicks;			//ʵʾ
+
+	cyclesPerTick = SystemCoreClock / OS_PORT_TICK_HZ;
+	maxTicks      = SysTick_LOAD_RELOAD_Msk / cyclesPerTick;
+	if(ticks > maxTicks)
+	{
+		ticks = maxTicks;
+	}
+
+	//ֹͣSysTick ԵǰʣļΪ ӳ ticks-1 
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	reload = SysTick->VAL + cyclesPerTick * (ticks - 1);
+	SysTick->LOAD = reload;
+	SysTick->VAL  = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	__disable_irq();
+	__set_BASEPRI(0);
+	__DSB();
+	__WFI();
+	__ISB();
+	__set_BASEPRI(OS_PORT_BASEPRI_SYSCALL);
+	__enable_irq();	//ֻӳжڴ˴ִ
+
+	//ֹͣSysTick жϻԭ
+	ctrl = SysTick->CTRL;
+	SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+	if(ctrl & SysTick_CTRL_COUNTFLAG_Msk)
+	{
+		//˯SysTickжѹ װΪreload ֻһһں
+		elapsedCycles = reload - SysTick->VAL;
+		if(elapsedCycles >= cyclesPerTick - 1)
+		{
+			SysTick->LOAD = cyclesPerTick - 1;
+		}
+		else
+		{
+			SysTick->LOAD = (cyclesPerTick - 1) - elapsedCycles;
+		}
+		sleptTicks = ticks - 1;
+	}
+	else
+	{
+		//жǰѣ ²Ϊһĵļ
+		elapsedCycles = ticks * cyclesPerTick - SysTick->VAL;
+		sleptTicks    = elapsedCycles / cyclesPerTick;
+		SysTick->LOAD = (sleptTicks + 1) * cyclesPerTick - elapsedCycles;
+	}
+
+	//µװֵʼ ָ֮Ϊ1ĵ
+	SysTick->VAL  = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = cyclesPerTick - 1;
+
+	return sleptTicks;
+}
+#endif	//OS_CFG_TICKLESS_EN
@@ -91,6 +91,7 @@ extern OS_TASK_HANDLE *g_pCurrentTask;
 *           (2) ΪڽϢСÿԴһ msgQueue
 *           (3) д洢ռ OSMalloc() 䣬msgBase ָλ
 *           (4) ʼΪգcount=0inIdx=0outIdx=0
+*           (5) countMax Ϊ0ʱ仺 иֶ(ɾע񲻲ɶ)
 *********************************************************************************************************/
 void OS_QInit(OS_TASK_HANDLE* p_tcb, u32 countMax)
 {
@@ -101,15 +102,21 @@ void OS_QInit(OS_TASK_HANDLE* p_tcb, u32 countMax)
 		return;
 	}
 	
+	p_que = &p_tcb->msgQueue;
+	
 	if(countMax == 0)
 	{
+		p_que->objType = OS_OBJ_TYPE_NONE;
+		p_que->msgBase = NULL;
+		p_que->countMax = 0;
+		p_que->count = 0;
+		p_que->inIdx = 0;
+		p_que->outIdx = 0;
 		return;
 	}
 	
-	p_que = &p_tcb->msgQueue;
-	
 	p_que->objType = OS_OBJ_TYPE_Q;
-	p_que->msgBase = OSMalloc(countMax);
+	p_que->msgBase = OSMalloc(countMax * sizeof(u32));
 	if(p_que->msgBase == NULL)
 	{
 		printf("ERROR:[OS_QInit] Malloc Failed!\r\n");
@@ -121,6 +128,34 @@ void OS_QInit(OS_TASK_HANDLE* p_tcb, u32 countMax)
 	p_que->outIdx = 0;
 }
 
+/*********************************************************************************************************
+* : OS_QFree
+* : ͷϢл
+* : 
+* : void
+*   ֵ: void
+* : 20260217
+* ע    : 
+*						(1) û  OSTaskDelete ٽڵ δȡߵϢһ
+*           (2) ͷź countMax Ϊ0 ֮Ϣ дͷŵڴ
+*********************************************************************************************************/
+void OS_QFree(OS_TASK_HANDLE* p_tcb)
+{
+	OS_Q *p_que;
+
+	p_que = &p_tcb->msgQueue;
+	if(p_que->msgBase != NULL)
+	{
+		OSFree(p_que->msgBase);
+	}
+	p_que->objType = OS_OBJ_TYPE_NONE;
+	p_que->msgBase = NULL;
+	p_que->countMax = 0;
+	p_que->count = 0;
+	p_que->inIdx = 0;
+	p_que->outIdx = 0;
+}
+
 /*********************************************************************************************************
 * : OSQPost
 * : 4ֽڷϢ
@@ -154,6 +189,7 @@ void OSQPost(OS_TASK_HANDLE* p_tcb, u32 msg)
   if(p_tcb == NULL)
 	{
 		printf("ERROR:[OSQPost] Illegal argument!\r\n");
+		OS_EXIT_CRITICAL();
 		return;
 	}
 
@@ -161,11 +197,10 @@ void OSQPost(OS_TASK_HANDLE* p_tcb, u32 msg)
   //շǷڹȴϢ
 	if(p_tcb->state == OS_TASK_PEND && p_tcb->pendObj == (void*)p_que)
 	{
+		OS_TRACE(OS_TRACE_Q_POST, p_que, 1);
 		//Ϣֱӷ TCB Ԥ
 		p_tcb->msgTemp = msg;
-		p_tcb->state = OS_TASK_READY;
-		p_tcb->pendObj = NULL;
-		OS_RdyTaskAdd(p_tcb);
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
 		OS_EXIT_CRITICAL();
 		
 		//
@@ -174,6 +209,7 @@ void OSQPost(OS_TASK_HANDLE* p_tcb, u32 msg)
 	}
 
 	//ȴ 뻷λ
+	OS_TRACE(OS_TRACE_Q_POST, p_que, 0);
 	if(p_que->count < p_que->countMax) //û
 	{
 		p_que->msgBase[p_que->inIdx] = msg;
@@ -211,9 +247,23 @@ void OSQPost(OS_TASK_HANDLE* p_tcb, u32 msg)
 *              - Ϣɷͷд g_pCurrentTask->msgTemp
 *              -  msgTemp ȡϢظû
 *
-*           (4) TODO: ʵֲֳ֧ʱȴҪʱ Tick/ʱչ
+*           (4) õȴ ȼ OSQPendTimeout(p_msg, OS_WAIT_FOREVER)
 *********************************************************************************************************/
 void OSQPend(u32 *p_msg)
+{
+	OSQPendTimeout(p_msg, OS_WAIT_FOREVER);
+}
+
+/*********************************************************************************************************
+* : OSQPendTimeout
+* : ʱȴϢϢ
+* : timeout: ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* : p_msg: Ϣĵַ ʱʱ޸
+*   ֵ: OS_PEND_OK: յϢ OS_PEND_TIMEOUT: ȴʱ OS_PEND_ERR: 
+* : 20260208
+* ע    : ڽϢûйб ʱֻʱбм¼ʱ
+*********************************************************************************************************/
+OS_PEND_STAT OSQPendTimeout(u32 *p_msg, u32 timeout)
 {
 	OS_Q *p_que;
 	
@@ -223,30 +273,40 @@ void OSQPend(u32 *p_msg)
 	if(p_msg == NULL)
 	{
 		printf("ERROR:[OSQPend] Illegal argument!\r\n");
-		return;
+		OS_EXIT_CRITICAL();
+		return OS_PEND_ERR;
 	}
 
 	//ϢǷϢԻȡ
 	p_que = &g_pCurrentTask->msgQueue;
+	OS_TRACE(OS_TRACE_Q_PEND, p_que, p_que->count == 0);
 	if(p_que->count > 0)
 	{
 		*p_msg = p_que->msgBase[p_que->outIdx];
 		p_que->outIdx = (p_que->outIdx + 1) % p_que->countMax;
 		p_que->count--;
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_OK;
 	}
 
 	// ǰ
-	g_pCurrentTask->state = OS_TASK_PEND;
-	g_pCurrentTask->pendObj = &g_pCurrentTask->msgQueue;
-	OS_RdyTaskRemove(g_pCurrentTask);
+	if(OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSQPend] Scheduler is locked!\r\n");
+		OS_EXIT_CRITICAL();
+		return OS_PEND_ERR;
+	}
+	OS_PendTaskBlock(NULL, (void*)p_que, timeout);
 	
 	OS_EXIT_CRITICAL();
 	OS_Sched(); 
 
 	// OSQPost ѻصʱ ϢѴ TCB 
-	*p_msg = g_pCurrentTask->msgTemp;
+	if(g_pCurrentTask->pendStat == OS_PEND_OK)
+	{
+		*p_msg = g_pCurrentTask->msgTemp;
+	}
+	return g_pCurrentTask->pendStat;
 }
 
 /*********************************************************************************************************
@@ -141,6 +141,7 @@ void OSSemPost(OS_SEM *p_sem)
 	}
 	
 	p_pend_list = &p_sem->pendList;
+	OS_TRACE(OS_TRACE_SEM_POST, p_sem, p_pend_list->headPtr != NULL);
 	if(p_pend_list->headPtr == NULL)	//бû
 	{
 		if(p_sem->count >= p_sem->countMax)	//źѾﵽֵ
@@ -156,9 +157,7 @@ void OSSemPost(OS_SEM *p_sem)
 	{
 		p_tcb = OS_PendListGetHighest(p_pend_list);
 		OS_PendListRemove(p_pend_list, p_tcb);
-		OS_RdyTaskAdd(p_tcb);
-		p_tcb->state = OS_TASK_READY;
-		p_tcb->pendObj = (void*)NULL;
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
 	}
 	
 	OS_EXIT_CRITICAL();
@@ -180,9 +179,25 @@ void OSSemPost(OS_SEM *p_sem)
 *              - źб OS_PendListInsert()
 *              - state Ϊ OS_TASK_PEND
 *              - pendObj ָź
-*           (4) TODO: ʱƣ賬ʱȴӦչ tick ߼
+*           (4) õȴ ȼ OSSemPendTimeout(p_sem, OS_WAIT_FOREVER)
 *********************************************************************************************************/
 void OSSemPend(OS_SEM *p_sem)
+{
+	OSSemPendTimeout(p_sem, OS_WAIT_FOREVER);
+}
+
+/*********************************************************************************************************
+* ƣOSSemPendTimeout
+* ܣʱȴź
+* p_sem: źָ timeout: ʱ(ms) OS_WAIT_FOREVER ʾõȴ
+* void
+*   ֵOS_PEND_OK: ź OS_PEND_TIMEOUT: ȴʱ OS_PEND_ERR: 
+* ڣ20260208
+* ע    ⣺
+*           (1) ʱͬʱźбʱб
+*           (2) ʱ OS_TickUpdate Ƴб  OS_PEND_TIMEOUT
+*********************************************************************************************************/
+OS_PEND_STAT OSSemPendTimeout(OS_SEM *p_sem, u32 timeout)
 {
 	OS_ENTER_CRITICAL();
 	
@@ -190,33 +205,41 @@ void OSSemPend(OS_SEM *p_sem)
 	{
 		printf("ERROR:[OSSemPend] Illegal argument!\r\n");
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_ERR;
 	}
 	if(p_sem->objType != OS_OBJ_TYPE_SEM)
 	{
 		printf("ERROR:[OSSemPend] Invaild Semapore!\r\n");
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_ERR;
 	}
 	
+	OS_TRACE(OS_TRACE_SEM_PEND, p_sem, p_sem->count == 0);
+	
 	//źԴ ֱӷ
 	if(p_sem->count > 0)
 	{
 		p_sem->count--;
 		OS_EXIT_CRITICAL();
-		return;
+		return OS_PEND_OK;
 	}
 	else	//ûпõԴ ȴ
 	{
-		OS_RdyTaskRemove(g_pCurrentTask);
-		OS_PendListInsert(&p_sem->pendList, g_pCurrentTask);
-		g_pCurrentTask->state = OS_TASK_PEND;
-		g_pCurrentTask->pendObj = (void*)p_sem;
+		if(OS_SchedIsLocked())
+		{
+			printf("ERROR:[OSSemPend] Scheduler is locked!\r\n");
+			OS_EXIT_CRITICAL();
+			return OS_PEND_ERR;
+		}
+		OS_PendTaskBlock(&p_sem->pendList, (void*)p_sem, timeout);
 	}
 	
 	//
 	OS_EXIT_CRITICAL();
 	OS_Sched();
+	
+	// OSSemPost ѻȴʱص
+	return g_pCurrentTask->pendStat;
 }
 
 #endif	//OS_CFG_SEM_EN
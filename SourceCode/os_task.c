@@ -8,7 +8,7 @@
 *   				(1) άȫ(ڱ/)
 *   				(2) ά(ȼ֣ÿһFIFO, prioֵԽСȼԽ)
 *   				(3) άȼλͼ(O(1)λȼ)
-*   				(4) άʱ(tickOS_Delay/ʱ)
+*   				(4) άʱ(tickϣʱ֣OS_Delay/ʱ)
 *   				(5) ά(ź//Ϣеȵȴ)
 * ˵:
 *   				- ȼģ:
@@ -16,6 +16,10 @@
 *       				: prioֵԽСȼԽ(RTOS)
 *       				λͼΪ __builtin_clz() bitתӳ:
 *           		bit_index = 31 - prio
+*       				OS_CFG_PRIO_MAX > 32 ʱʹλͼ(256):
+*           		λͼ bit(31 - prio/32) ʾо
+*           		λͼ bit(31 - prio%32) ʾȼо
+*           		ȼ = CLZ(λͼ) * 32 + CLZ(λͼ)
 *
 *   				- ģ:
 *       				s_OSRdyLists[prio] һ˫
@@ -26,9 +30,15 @@
 *       				head->tick ÿSysTick10Ѹ
 *       				/ɾҪάtickĲֵ֤Ч
 *
+*   				- ʱģ(ϣʱ OS_CFG_TICK_WHEEL_EN):
+*       				tick Եʱ̣ tick % OS_CFG_TICK_WHEEL_SIZE ҵӦ۵˫
+*       				/ɾΪO(1)ÿֻ鵱ǰۣڵʱδһȦ
+*
 *   				- ģ:
 *       				OS_PEND_LIST ڶȴ(ȼ)
 *       				Insertʱȼ룬GetHighestֱӷͷ
+*       				ʱĵȴͬʱڶкʱϣ
+*       				ȱ Post ƳʱУȵ OS_TickUpdate Ƴвǳʱ
 * ע    :           
 *   				(1) лر(g_pCurrentTask)ٽ޸
 *   				(2) /ʱ/еĲ뱣֤ԭ
@@ -50,6 +60,22 @@
 /*********************************************************************************************************
 *                                              궨
 *********************************************************************************************************/
+#if OS_CFG_PRIO_MAX > 256
+#error "OS_CFG_PRIO_MAX must not exceed 256"
+#endif
+
+#if OS_CFG_PRIO_MAX > 32
+#define OS_PRIO_GRP_NUM ((OS_CFG_PRIO_MAX + 31) / 32)	//λͼ(ÿ32ȼ)
+#endif
+
+#if OS_CFG_TICK_WHEEL_EN != 0
+#if (OS_CFG_TICK_WHEEL_SIZE & (OS_CFG_TICK_WHEEL_SIZE - 1)) != 0
+#error "OS_CFG_TICK_WHEEL_SIZE must be a power of 2"
+#endif
+#define OS_TICK_WHEEL_MASK ((u64)OS_CFG_TICK_WHEEL_SIZE - 1)	//ʱ -> ±
+#endif
+
+#define OS_RUNTIME_SYNC_TICKS 1024	//лʱʱĲ( 2)
 
 /*********************************************************************************************************
 *                                              öٽṹ
@@ -60,18 +86,158 @@
 *********************************************************************************************************/
 OS_TASK_HANDLE g_OSTaskListHead;	//ȫ(ڹ/ )
 static OS_RDY_LIST s_OSRdyLists[OS_CFG_PRIO_MAX];	//б(ÿȼһ˫)
+#if OS_CFG_PRIO_MAX <= 32
 static u32 s_OSPrioBitMap;	//ȼλͼ 0- 1-ǿ 32λ32ȼ bit[0]ȼ bit[31]ȼ
-//TODO: չΪ(ָ֧ȼ)
+#else
+static u32 s_OSPrioGrpMap;									//λͼ bit[31-g]=1 ʾgо
+static u32 s_OSPrioBitMap[OS_PRIO_GRP_NUM];	//λͼ ÿ32ȼ ӳ䷽ʽ뵥λͼͬ
+#endif
+#if OS_CFG_TICK_WHEEL_EN != 0
+static OS_TASK_HANDLE* s_OSTickWheel[OS_CFG_TICK_WHEEL_SIZE];	//ʱ ÿһ˫ͷָ
+static u32            s_OSTickWheelCnt;											//ʱе
+#else
 static OS_TICK_LIST s_OSTickList;	//б
+#endif
+static u64          s_OSTickCnt;		//ϵͳļ(tick)
+#if OS_CFG_TASK_PROFILE_EN != 0
+static u32          s_OSRunTimeStamp;	//ϴμʱʱ
+static u64          s_OSRunTimeSnap;	//ϴοʱʱ(֮)
+static u64          s_OSRunTimeTotal;	//ʱ֮
+#endif
 extern OS_TASK_HANDLE* g_pCurrentTask;
+extern volatile u8 g_OSSchedFlag;
 
 /*********************************************************************************************************
 *                                              ڲ
 *********************************************************************************************************/
+static u8   OS_TickTaskIsIn(OS_TASK_HANDLE *p_tcb);		//Ƿʱб
+static void OS_TickTaskExpire(OS_TASK_HANDLE *p_tcb);	//ʱ/ȴʱڴ
+static void OS_TaskWaitEnd(OS_TASK_HANDLE *p_tcb);		//ʱ/ȴ ת(򱣳ֹ)
+#if OS_CFG_TASK_PROFILE_EN != 0
+static void OS_TaskRunTimeUpdate(void);								//ϴμʱǵǰ
+#endif
+#if OS_CFG_TICK_WHEEL_EN != 0
+static void OS_TickWheelExpire(u32 slot);							//ʱĳѵڵ
+#endif
 
 /*********************************************************************************************************
 *                                              ڲʵ
 *********************************************************************************************************/
+/*********************************************************************************************************
+* : OS_TickTaskIsIn
+* : жǷʱб
+* : p_tcb: 
+* : void
+*   ֵ: 1-ʱб 0-
+* : 20260208
+* ע    : ͷǰָΪ Ҫж
+*********************************************************************************************************/
+static u8 OS_TickTaskIsIn(OS_TASK_HANDLE *p_tcb)
+{
+#if OS_CFG_TICK_WHEEL_EN != 0
+	return (p_tcb->tickPrevPtr != NULL || s_OSTickWheel[p_tcb->tick & OS_TICK_WHEEL_MASK] == p_tcb);
+#else
+	return (p_tcb->tickPrevPtr != NULL || s_OSTickList.headPtr == p_tcb);
+#endif
+}
+
+/*********************************************************************************************************
+* : OS_TickTaskExpire
+* : ʱڴ Ƴʱбб
+* : p_tcb: ڵ
+* : void
+*   ֵ: void
+* : 20260208
+* ע    : 
+*           (1) ڵȴں˶˵ȴʱƳб Ϊ OS_PEND_TIMEOUT
+*           (2) ȴʱس¼ owner ļ̳ȼ ɱ񴫵ȥĲ
+*********************************************************************************************************/
+static void OS_TickTaskExpire(OS_TASK_HANDLE *p_tcb)
+{
+	OS_PEND_LIST *p_pend_list;
+	void *p_obj;
+
+	OS_TickTaskRemove(p_tcb);
+
+	if(p_tcb->state != OS_TASK_PEND || p_tcb->pendObj == NULL)	//ͨʱ
+	{
+		OS_TaskWaitEnd(p_tcb);
+		return;
+	}
+
+	p_obj = p_tcb->pendObj;
+	p_pend_list = OS_ObjPendListGet(p_obj);
+	if(p_pend_list != NULL)
+	{
+		OS_PendListRemove(p_pend_list, p_tcb);
+	}
+#if OS_CFG_FLAG_EN != 0
+	p_tcb->flagsMaskPendOn = 0;
+	p_tcb->flagsPendOpt = OS_FLAG_WAIT_NONE;
+#endif
+	OS_PendTaskReady(p_tcb, OS_PEND_TIMEOUT);
+
+#if OS_CFG_MUTEX_EN != 0 && OS_CFG_MUTEX_PI_EN != 0
+	if(*(OS_OBJ_TYPE*)p_obj == OS_OBJ_TYPE_MUTEX)	//ϸԶ owner Ҳܼ̳˱ȼ
+	{
+		OS_MutexPrioRestore((OS_MUTEX*)p_obj);
+	}
+#endif
+}
+
+/*********************************************************************************************************
+* : OS_TaskWaitEnd
+* : ʱ/ȴ б
+* : p_tcb: (Ƴʱб͹б)
+* : void
+*   ֵ: void
+* : 20260217
+* ע    : ȴڼ䱻 OSTaskSuspend 񲻼б ת OS_TASK_STOP  OSTaskResume ָ
+*********************************************************************************************************/
+static void OS_TaskWaitEnd(OS_TASK_HANDLE *p_tcb)
+{
+#if OS_CFG_TASK_SUSPEND_EN != 0
+	if(p_tcb->suspended)
+	{
+		p_tcb->state = OS_TASK_STOP;
+		return;
+	}
+#endif
+	p_tcb->state = OS_TASK_READY;
+	OS_RdyTaskAdd(p_tcb);
+}
+
+#if OS_CFG_TASK_PROFILE_EN != 0
+/*********************************************************************************************************
+* : OS_TaskRunTimeUpdate
+* : ϴμʱǵǰ
+* : void
+* : void
+*   ֵ: void
+* : 20260211
+* ע    : 
+*           (1) ٽڵ ÿлǰͶȡͳǰһ
+*           (2) ʱΪ32λ μ˼ܳһ(CYCCNT@120MHzԼ35s)
+*               нĲ PendSV  OS_TickUpdate ÿ OS_RUNTIME_SYNC_TICKS Ĳһ
+*               tickless ǽĺҲһ
+*********************************************************************************************************/
+static void OS_TaskRunTimeUpdate(void)
+{
+	u32 now;
+	u32 delta;
+
+	now = OS_PortTimestampGet();
+	delta = now - s_OSRunTimeStamp;	//޷żԶ
+	s_OSRunTimeStamp = now;
+
+	if(g_pCurrentTask != NULL)
+	{
+		g_pCurrentTask->runTime += delta;
+		s_OSRunTimeTotal += delta;
+	}
+}
+#endif	//OS_CFG_TASK_PROFILE_EN
+
 /*********************************************************************************************************
 * : StrCaseCmp
 * : жַǷ(ԴСд)
@@ -137,7 +303,7 @@ void OSInitTaskSched(void)
 *********************************************************************************************************/
 OS_TASK_HANDLE* OSTaskFind(OS_TASK_ID_TYPE opt, void* key)
 {
-	OS_TASK_HANDLE *p_tcb = &g_OSTaskListHead;
+	OS_TASK_HANDLE *p_tcb = g_OSTaskListHead.nextPtr;	//ڱ
 	
 	switch (opt)
 	{
@@ -188,221 +354,1119 @@ OS_TASK_HANDLE* OSTaskFind(OS_TASK_ID_TYPE opt, void* key)
 * : 20260122
 * ע    : û ںʹ
 *						ѡ񡱣ʵлͨPendSV
+*						ʹ OS_CFG_TASK_PROFILE_EN ʱʱ
+*						ʹ OS_CFG_TRACE_EN ʱ¼л¼
+*						õ ͬʱ g_OSSchedFlag ֮ÿ OSIntExit ظ
 *********************************************************************************************************/
 void OS_UpdateCurrentTask(void)
 {
 	u32 prio;
+#if OS_CFG_TASK_PROFILE_EN != 0 || OS_CFG_TRACE_EN != 0
+	OS_TASK_HANDLE *p_prev;
+#endif
 
 	OS_ENTER_CRITICAL();
 
+#if OS_CFG_TASK_PROFILE_EN != 0
+	OS_TaskRunTimeUpdate();	//ǰʱǵǰ
+#endif
+#if OS_CFG_TASK_PROFILE_EN != 0 || OS_CFG_TRACE_EN != 0
+	p_prev = g_pCurrentTask;
+#endif
+
 	//λͼҵȼߵ
 	prio = OS_BitMapGetHighest();
 	//صPendSVл
 	g_pCurrentTask = s_OSRdyLists[prio].headPtr;
+	g_OSSchedFlag = 0;
+
+#if OS_CFG_TASK_PROFILE_EN != 0
+	if(g_pCurrentTask != p_prev)
+	{
+		g_pCurrentTask->switchCnt++;
+	}
+#endif
+#if OS_CFG_TRACE_EN != 0
+	if(g_pCurrentTask != p_prev)
+	{
+		OS_TRACE(OS_TRACE_TASK_SWITCH, g_pCurrentTask, (p_prev != NULL) ? p_prev->traceId : OS_TRACE_ID_NONE);
+	}
+#endif
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* : OS_SchedNeeded
+* : жȼǷѲǵǰ
+* : void
+* : void
+*   ֵ: 1-Ҫл 0-ǰӦ
+* : 20260215
+* ע    : û SysTick_Handler ڽĴ֮ Ϊ0ʱ PendSV
+*           ʼվ λͼΪ
+*********************************************************************************************************/
+u8 OS_SchedNeeded(void)
+{
+	return (s_OSRdyLists[OS_BitMapGetHighest()].headPtr != g_pCurrentTask) ? 1 : 0;
+}
+
+/*********************************************************************************************************
+* : OSTaskChangePrio
+* : ʱ޸ȼ
+* : p_tcb:  NULLʾǰ prio: µĻȼ
+* : void
+*   ֵ: void
+* : 20260218
+* ע    : 
+*           (1) ޸ĵ basePriority ȼ̳бʱ ǰȼȡеĽϸ
+*           (2) Ƶȼбĩβ ȴеڶбаȼ
+*               ֮ Post ȼѡѶ
+*           (3) ȴȼı ͬʱ owner ļ̳ȼ(OS_CFG_MUTEX_PI_EN)
+*           (4) жϺоɵ жвʹNULL ޸Ŀ Ҳʹÿȼ
+*********************************************************************************************************/
+void OSTaskChangePrio(OS_TASK_HANDLE *p_tcb, u32 prio)
+{
+	u32 prioOld;
+
+	if(prio >= OS_CFG_PRIO_MAX - 1)
+	{
+		printf("ERROR:[OSTaskChangePrio] Illegal priority %u!\r\n", prio);
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(p_tcb == NULL)
+	{
+		if(OS_InISR())
+		{
+			printf("ERROR:[OSTaskChangePrio] Can not change self in ISR!\r\n");
+			OS_EXIT_CRITICAL();
+			return;
+		}
+		p_tcb = g_pCurrentTask;
+	}
+	if(p_tcb == OS_IdleTaskGet())
+	{
+		printf("ERROR:[OSTaskChangePrio] Can not change IdleTask!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	prioOld = p_tcb->priority;
+	p_tcb->basePriority = prio;
+#if OS_CFG_MUTEX_EN != 0 && OS_CFG_MUTEX_PI_EN != 0
+	prio = OS_MutexPrioCalc(p_tcb);	//Աȴʱּ̳ȼ
+#endif
+	if(prio != prioOld)
+	{
+		OS_TaskPrioSet(p_tcb, prio);
+#if OS_CFG_MUTEX_EN != 0 && OS_CFG_MUTEX_PI_EN != 0
+		if(p_tcb->state == OS_TASK_PEND && p_tcb->pendObj != NULL && *(OS_OBJ_TYPE*)p_tcb->pendObj == OS_OBJ_TYPE_MUTEX)
+		{
+			OS_MutexPendPrioChange((OS_MUTEX*)p_tcb->pendObj, prioOld, prio);
+		}
+#endif
+	}
+
+	OS_EXIT_CRITICAL();
+	OS_Sched();
+}
+
+#if OS_CFG_TASK_SUSPEND_EN != 0
+/*********************************************************************************************************
+* : OSTaskSuspend
+* : 
+* : p_tcb:  NULLʾǰ
+* : void
+*   ֵ: void
+* : 20260217
+* ע    : 
+*           (1) Ƴб ״̬Ϊ OS_TASK_STOP
+*           (2) ʱȴ񱣳ʱб/б ȴճ(յԴʱ)
+*               󲻼бת OS_TASK_STOP ָӿڷ ᶪʧѽԴ
+*           (3) 𲻼ƴ ظָֻһ
+*           (4) жпԹ  ڼ䲻Լ
+*********************************************************************************************************/
+void OSTaskSuspend(OS_TASK_HANDLE *p_tcb)
+{
+	OS_ENTER_CRITICAL();
+
+	if(p_tcb == NULL)
+	{
+		if(OS_InISR())
+		{
+			printf("ERROR:[OSTaskSuspend] Can not suspend self in ISR!\r\n");
+			OS_EXIT_CRITICAL();
+			return;
+		}
+		p_tcb = g_pCurrentTask;
+	}
+	if(p_tcb == OS_IdleTaskGet())
+	{
+		printf("ERROR:[OSTaskSuspend] Can not suspend IdleTask!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	if(p_tcb == g_pCurrentTask && !OS_InISR() && OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSTaskSuspend] Scheduler is locked!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	if(p_tcb->suspended || (p_tcb->state == OS_TASK_STOP))	//ѱѱɾ
+	{
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	p_tcb->suspended = 1;
+	if(p_tcb->state == OS_TASK_READY)
+	{
+		OS_RdyTaskRemove(p_tcb);
+		p_tcb->state = OS_TASK_STOP;
+	}
+
+	OS_EXIT_CRITICAL();
+	OS_Sched();
+}
+
+/*********************************************************************************************************
+* : OSTaskResume
+* : ָ
+* : p_tcb: 
+* : void
+*   ֵ: void
+* : 20260217
+* ע    : 
+*           (1) ĵȴѾ(OS_TASK_STOP)ʱб ڵȴʱֻ
+*           (2) жоɵ δ
+*********************************************************************************************************/
+void OSTaskResume(OS_TASK_HANDLE *p_tcb)
+{
+	if(p_tcb == NULL)
+	{
+		printf("ERROR:[OSTaskResume] Illegal argument!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(!p_tcb->suspended)
+	{
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	p_tcb->suspended = 0;
+	if(p_tcb->state == OS_TASK_STOP)
+	{
+		p_tcb->state = OS_TASK_READY;
+		OS_RdyTaskAdd(p_tcb);
+	}
+
+	OS_EXIT_CRITICAL();
+	OS_Sched();
+}
+#endif	//OS_CFG_TASK_SUSPEND_EN
+
+#if OS_CFG_TASK_DEL_EN != 0
+/*********************************************************************************************************
+* : OSTaskDelete
+* : ɾ
+* : p_tcb:  NULLʾǰ
+* : void
+*   ֵ: void
+* : 20260217
+* ע    : 
+*           (1) ״̬Ƴб/ʱб/б Ƴȫ ״̬Ϊ OS_TASK_STOP
+*           (2) ȴɾ¼ owner ļ̳ȼ
+*           (3) ͷڽϢл δȡߵϢһ
+*           (4) ɾԼʱ TCB ջлȥ֮Ųٱʹ
+*               ֮ͬһ TCB ջ OSRegister ڰ贴ʱ
+*           (5) лɾ ȴԶò ͷеȫ
+*           (6) ɾ ڼ䲻ɾԼ
+*********************************************************************************************************/
+void OSTaskDelete(OS_TASK_HANDLE *p_tcb)
+{
+	OS_PEND_LIST *p_pend_list;
+	void *p_obj;
+
+	OS_ENTER_CRITICAL();
+
+	if(p_tcb == NULL)
+	{
+		if(OS_InISR())
+		{
+			printf("ERROR:[OSTaskDelete] Can not delete self in ISR!\r\n");
+			OS_EXIT_CRITICAL();
+			return;
+		}
+		p_tcb = g_pCurrentTask;
+	}
+	if(p_tcb == OS_IdleTaskGet())
+	{
+		printf("ERROR:[OSTaskDelete] Can not delete IdleTask!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	if(p_tcb == g_pCurrentTask && !OS_InISR() && OS_SchedIsLocked())
+	{
+		printf("ERROR:[OSTaskDelete] Scheduler is locked!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+#if OS_CFG_TASK_SUSPEND_EN != 0
+	if(p_tcb->state == OS_TASK_STOP && !p_tcb->suspended)
+#else
+	if(p_tcb->state == OS_TASK_STOP)
+#endif
+	{
+		printf("ERROR:[OSTaskDelete] Task %s already deleted!\r\n", p_tcb->taskName);
+		OS_EXIT_CRITICAL();
+		return;
+	}
+#if OS_MUTEX_HELD_EN != 0
+	if(p_tcb->mutexHeldPtr != NULL)
+	{
+		printf("ERROR:[OSTaskDelete] Task %s holds a mutex!\r\n", p_tcb->taskName);
+		OS_EXIT_CRITICAL();
+		return;
+	}
+#endif
+
+	switch(p_tcb->state)
+	{
+		case OS_TASK_READY:
+			OS_RdyTaskRemove(p_tcb);
+			break;
+		case OS_TASK_DELAY:
+			OS_TickTaskRemove(p_tcb);
+			break;
+		case OS_TASK_PEND:
+			p_obj = p_tcb->pendObj;
+			if(OS_TickTaskIsIn(p_tcb))
+			{
+				OS_TickTaskRemove(p_tcb);
+			}
+			p_pend_list = OS_ObjPendListGet(p_obj);
+			if(p_pend_list != NULL)
+			{
+				OS_PendListRemove(p_pend_list, p_tcb);
+			}
+			p_tcb->pendObj = NULL;
+#if OS_CFG_FLAG_EN != 0
+			p_tcb->flagsMaskPendOn = 0;
+			p_tcb->flagsPendOpt = OS_FLAG_WAIT_NONE;
+#endif
+#if OS_CFG_MUTEX_EN != 0 && OS_CFG_MUTEX_PI_EN != 0
+			if(*(OS_OBJ_TYPE*)p_obj == OS_OBJ_TYPE_MUTEX)
+			{
+				OS_MutexPrioRestore((OS_MUTEX*)p_obj);
+			}
+#endif
+			break;
+		default:	//Ҳκб
+			break;
+	}
+
+	p_tcb->state = OS_TASK_STOP;
+#if OS_CFG_TASK_SUSPEND_EN != 0
+	p_tcb->suspended = 0;
+#endif
+	OS_TaskListRemove(p_tcb);
+#if OS_CFG_Q_EN != 0
+	OS_QFree(p_tcb);
+#endif
+#if OS_CFG_TRACE_EN != 0
+	OS_TraceTaskIdFree(p_tcb->traceId);
+#endif
+
+	OS_EXIT_CRITICAL();
+	OS_Sched();	//ɾԼʱлȥ ٷ
+}
+#endif	//OS_CFG_TASK_DEL_EN
+
+/*********************************************************************************************************
+* : OS_TaskReturn
+* : غĳ
+* : void
+* : void
+*   ֵ: void()
+* : 20260217
+* ע    : 
+*           (1) û ֲΪڵķصַ(Cortex-M ʼջ֡е LR)
+*           (2)  OS_CFG_TASK_DEL_EN ʱɾǰ ֱ return 
+*********************************************************************************************************/
+void OS_TaskReturn(void)
+{
+#if OS_CFG_TASK_DEL_EN != 0
+	OSTaskDelete(NULL);
+#endif
+	printf("ERROR:[OS_TaskReturn] Task %s Returned!\r\n", g_pCurrentTask->taskName);
+	while(1){}
+}
+
+#if OS_CFG_TASK_PROFILE_EN != 0
+/*********************************************************************************************************
+* : OSTaskRunInfoGet
+* : ȫ ÿͳ
+* : p_info:  maxNum:  p_load: CPUַ(ǧֱ ΪNULL)
+* : p_info: ͳ p_load: ͳƴڵCPU
+*   ֵ: д p_info 
+* : 20260211
+* ע    : 
+*           (1) ͳƴΪϴεñ(״εΪ) Եüɵõʱεռ
+*           (2) CPU = 1 - ʱ / ʱ
+*           (3) ٽ ϶ʱӳжʱ ڵȼе
+*********************************************************************************************************/
+u32 OSTaskRunInfoGet(OS_TASK_RUNINFO *p_info, u32 maxNum, u16 *p_load)
+{
+	OS_TASK_HANDLE *p_tcb;
+	OS_TASK_HANDLE *p_idle;
+	u64 window;
+	u64 delta;
+	u32 freq;
+	u32 num;
+
+	if(p_info == NULL && maxNum != 0)
+	{
+		printf("ERROR:[OSTaskRunInfoGet] Illegal argument!\r\n");
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	OS_TaskRunTimeUpdate();	//ѵǰеһҲ
+	freq = OS_PortTimestampFreq();
+	window = s_OSRunTimeTotal - s_OSRunTimeSnap;
+	s_OSRunTimeSnap = s_OSRunTimeTotal;
+
+	if(p_load != NULL)
+	{
+		p_idle = OS_IdleTaskGet();
+		delta = p_idle->runTime - p_idle->runTimeSnap;
+		*p_load = (window == 0) ? 0 : (u16)(1000 - delta * 1000 / window);
+	}
+
+	num = 0;
+	for(p_tcb = g_OSTaskListHead.nextPtr; p_tcb != NULL; p_tcb = p_tcb->nextPtr)
+	{
+		delta = p_tcb->runTime - p_tcb->runTimeSnap;
+		p_tcb->runTimeSnap = p_tcb->runTime;
+
+		if(num < maxNum)
+		{
+			p_info[num].p_tcb     = p_tcb;
+			p_info[num].name      = p_tcb->taskName;
+			p_info[num].priority  = p_tcb->priority;
+			p_info[num].state     = p_tcb->state;
+			p_info[num].runTimeUs = (p_tcb->runTime / freq) * 1000000 + (p_tcb->runTime % freq) * 1000000 / freq;
+			p_info[num].switchCnt = p_tcb->switchCnt;
+			p_info[num].usage     = (window == 0) ? 0 : (u16)(delta * 1000 / window);
+			num++;
+		}
+	}
 
 	OS_EXIT_CRITICAL();
+
+	return num;
+}
+#endif	//OS_CFG_TASK_PROFILE_EN
+
+#if OS_CFG_TASK_STK_CHK_EN != 0
+/*********************************************************************************************************
+* : OSTaskStackFree
+* : ȡջʷСʣ
+* : p_tcb: 
+* : void
+*   ֵ: ջ(stackBase)Աֵ(λu32)
+* : 20260212
+* ע    : 
+*           (1) ջ ջŻᱻõλ ˴ stackBase ɨ赽һдּ
+*           (2) ֻɨ費ٽ ǵʱ̵Ľֵ
+*           (3) 0ʾջþ ܿѾ
+*********************************************************************************************************/
+u32 OSTaskStackFree(OS_TASK_HANDLE *p_tcb)
+{
+	u32 i;
+
+	if(p_tcb == NULL)
+	{
+		printf("ERROR:[OSTaskStackFree] Handle Is Null!\r\n");
+		return 0;
+	}
+
+	for(i = 0; i < p_tcb->stackSize; i++)
+	{
+		if(p_tcb->stackBase[i] != OS_TASK_STK_PATTERN)
+		{
+			break;
+		}
+	}
+	return i;
+}
+
+/*********************************************************************************************************
+* : OSTaskStackUsed
+* : ȡջʷʹ(ˮλ)
+* : p_tcb: 
+* : void
+*   ֵ: ջʹ(λu32)
+* : 20260212
+* ע    : ʼջ֡ ݴ˿ɰջС ʹ + 
+*********************************************************************************************************/
+u32 OSTaskStackUsed(OS_TASK_HANDLE *p_tcb)
+{
+	if(p_tcb == NULL)
+	{
+		printf("ERROR:[OSTaskStackUsed] Handle Is Null!\r\n");
+		return 0;
+	}
+
+	return p_tcb->stackSize - OSTaskStackFree(p_tcb);
+}
+
+/*********************************************************************************************************
+* : OSTaskStackReport
+* : ȫ ӡÿջСʹʣ
+* : void
+* : void
+*   ֵ: void
+* : 20260212
+* ע    : λΪֽ ʣΪ0
+*********************************************************************************************************/
+void OSTaskStackReport(void)
+{
+	OS_TASK_HANDLE *p_tcb;
+	u32 used;
+	u32 total;
+
+	printf("[Stack] %-12s %8s %8s %8s %6s\r\n", "Task", "Size", "Used", "Free", "Usage");
+	for(p_tcb = g_OSTaskListHead.nextPtr; p_tcb != NULL; p_tcb = p_tcb->nextPtr)
+	{
+		used = OSTaskStackUsed(p_tcb);
+		total = p_tcb->stackSize;
+		printf("[Stack] %-12s %8u %8u %8u %5u%%\r\n", p_tcb->taskName, total * 4, used * 4, (total - used) * 4,
+		       (total == 0) ? 0 : used * 100 / total);
+		if(used == total)
+		{
+			printf("Warning:[OSTaskStackReport] Stack of %s May Be Overflowed!\r\n", p_tcb->taskName);
+		}
+	}
+}
+#endif	//OS_CFG_TASK_STK_CHK_EN
+
+/*********************************************************************************************************
+* : OS_TaskListInit
+* : ʼȫб
+* : void
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : û ںʹ
+*********************************************************************************************************/
+void OS_TaskListInit(void)
+{
+	//ڱ(head) 洢ʵ
+	g_OSTaskListHead.nextPtr = NULL;
+}
+
+/*********************************************************************************************************
+* : OS_TaskListInit
+* : ȫбĩβ
+* : void
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : û ںʹ
+*						ȣOS_TaskFind/ͳ
+*********************************************************************************************************/
+void OS_TaskListAdd(OS_TASK_HANDLE *p_tcb)
+{
+	OS_TASK_HANDLE* pCurrTask;	//
+	
+	//
+	if(p_tcb == NULL)
+	{
+		return;
+	}
+	
+	pCurrTask = &g_OSTaskListHead;
+	while(pCurrTask->nextPtr != NULL)
+	{
+		pCurrTask = pCurrTask->nextPtr;
+	}
+	pCurrTask->nextPtr = p_tcb;
+	p_tcb->nextPtr = NULL;
+}
+
+/*********************************************************************************************************
+* : OS_TaskListRemove
+* : ȫбɾ
+* : void
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : û ںʹ
+*						ȣOS_TaskFind/ͳ
+*********************************************************************************************************/
+void OS_TaskListRemove(OS_TASK_HANDLE *p_tcb)
+{
+	OS_TASK_HANDLE* pPrevTask;	//Ҫɾǰ
+	OS_TASK_HANDLE* pCurrTask;	//Ҫɾ
+	
+	//
+	if(p_tcb == NULL)
+	{
+		return;
+	}
+	
+	pPrevTask = &g_OSTaskListHead;
+	while(pPrevTask->nextPtr != NULL)
+	{
+		if(pPrevTask->nextPtr == p_tcb)	//ҵǰ
+		{
+			//ӵɾ
+			pCurrTask = pPrevTask->nextPtr;
+			pPrevTask->nextPtr = pCurrTask->nextPtr;
+			pCurrTask->nextPtr = NULL;
+			return;
+		}
+		pPrevTask = pPrevTask->nextPtr;
+	}
+	
+	//ûҵ
+	printf("Warning: Cannot Find Task!\r\n");
+}
+
+/*********************************************************************************************************
+* : OS_RdyListInit
+* : ʼоб
+* : void
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : û ںʹ
+*********************************************************************************************************/
+void OS_RdyListInit(void)
+{
+	u32 i;
+
+	for (i = 0; i < OS_CFG_PRIO_MAX; i++)
+	{
+		s_OSRdyLists[i].headPtr = NULL;
+		s_OSRdyLists[i].tailPtr = NULL;
+	}
+}
+
+/*********************************************************************************************************
+* : OS_RdyTaskAdd
+* : ھбмһĩβ
+* : 
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : ֻܼ뵽ĳбĩβ ͬȼѭFCFSԭ
+*********************************************************************************************************/
+void OS_RdyTaskAdd(OS_TASK_HANDLE *p_tcb)
+{
+	OS_RDY_LIST *pRdyList;
+	u32 prio;
+
+	//
+	if(p_tcb == NULL)
+	{
+		return;
+	}
+
+	//ӾбҵӦȼľб
+	prio = p_tcb->priority;
+	pRdyList = &s_OSRdyLists[prio];
+
+#if OS_CFG_SCHED_RR_EN != 0
+	p_tcb->timeQuantaCtr = p_tcb->timeQuanta;	//ÿνбһʱƬ
+#endif
+
+	//뵽ĩβ
+	p_tcb->rdyNextPtr = NULL;
+	if(pRdyList->headPtr == NULL)	//þб
+	{
+		p_tcb->rdyPrevPtr = NULL;
+		pRdyList->headPtr = p_tcb;
+	}
+	else	//þбǿ
+	{
+		p_tcb->rdyPrevPtr = pRdyList->tailPtr;
+		pRdyList->tailPtr->rdyNextPtr = p_tcb;
+	}
+	pRdyList->tailPtr = p_tcb;	//ĸ βָ붼ָ¼ӽ
+
+	//λͼ λбȼλͼ
+	OS_BitMapSet(prio);
+}
+
+/*********************************************************************************************************
+* : OS_RdyTaskRemove
+* : ӾбƳ
+* : 
+* : void
+*   ֵ: void
+* : 20260122
+* ע    : ܴбλɾ
+						û ںʹ
+*********************************************************************************************************/
+void OS_RdyTaskRemove(OS_TASK_HANDLE *p_tcb)
+{
+	OS_RDY_LIST *pRdyList;
+	u32 prio;
+
+	//
+	if(p_tcb == NULL)
+	{
+		return;
+	}
+
+	//ӾбҵӦȼľб
+	prio = p_tcb->priority;
+	pRdyList = &s_OSRdyLists[prio];
+
+	//бͷƳ
+	if(p_tcb->rdyPrevPtr == NULL)	//ͷ
+	{
+		pRdyList->headPtr = p_tcb->rdyNextPtr;	//бͷָָһ
+		if(p_tcb->rdyNextPtr != NULL)	//滹н
+		{
+			p_tcb->rdyNextPtr->rdyPrevPtr = NULL;	//һͷ
+		}
+	}
+	else if(p_tcb->rdyNextPtr == NULL)//β
+	{
+		pRdyList->tailPtr = p_tcb->rdyPrevPtr;	//бβָָһ
+		p_tcb->rdyPrevPtr->rdyNextPtr = NULL;	//һβ
+	}
+	else	//м
+	{
+		p_tcb->rdyPrevPtr->rdyNextPtr = p_tcb->rdyNextPtr;
+		p_tcb->rdyNextPtr->rdyPrevPtr = p_tcb->rdyPrevPtr;
+	}
+	
+	p_tcb->rdyNextPtr = NULL;
+	p_tcb->rdyPrevPtr = NULL;
+
+	//λͼ þбѾû
+	if(pRdyList->headPtr == NULL)
+	{
+		OS_BitMapClr(prio);
+	}
+}
+
+/*********************************************************************************************************
+* : OS_TaskPrioSet
+* : ޸ǰȼ
+* : p_tcb:  prio: ȼ
+* : void
+*   ֵ: void
+* : 20260207
+* ע    : 
+*           (1) û ٽڵ ֻ޸ priority ޸ basePriority
+*           (2) ھбʱƵȼбĩβ
+*           (3) бȼ ȴйбʱƳٰȼ²
+*           (4) ʱ/Ȳбе״ֻ̬޸ȼ
+*********************************************************************************************************/
+void OS_TaskPrioSet(OS_TASK_HANDLE *p_tcb, u32 prio)
+{
+	OS_PEND_LIST *p_pend_list;
+
+	if(p_tcb == NULL || prio >= OS_CFG_PRIO_MAX)
+	{
+		printf("ERROR: [OS_TaskPrioSet] Illegal Argument!\r\n");
+		return;
+	}
+
+	if(p_tcb->state == OS_TASK_PEND && p_tcb->pendObj != NULL)
+	{
+		p_pend_list = OS_ObjPendListGet(p_tcb->pendObj);
+		if(p_pend_list != NULL)
+		{
+			OS_PendListRemove(p_pend_list, p_tcb);
+			p_tcb->priority = prio;
+			OS_PendListInsert(p_pend_list, p_tcb);
+			return;
+		}
+	}
+
+	//бͷǰָΪ Ҫж
+	if(p_tcb->rdyPrevPtr != NULL || s_OSRdyLists[p_tcb->priority].headPtr == p_tcb)
+	{
+		OS_RdyTaskRemove(p_tcb);
+		p_tcb->priority = prio;
+		OS_RdyTaskAdd(p_tcb);
+	}
+	else
+	{
+		p_tcb->priority = prio;
+	}
+}
+
+#if OS_CFG_SCHED_RR_EN != 0
+/*********************************************************************************************************
+* : OS_RdyListRotate
+* : ĳȼбͷƵĩβ װʱƬ
+* : prio: ȼ
+* : void
+*   ֵ: void
+* : 20260206
+* ע    : û ٽڵ бвʱ
+*********************************************************************************************************/
+void OS_RdyListRotate(u32 prio)
+{
+	OS_RDY_LIST *pRdyList;
+	OS_TASK_HANDLE *headTask;
+
+	pRdyList = &s_OSRdyLists[prio];
+	headTask = pRdyList->headPtr;
+	if(headTask == NULL || headTask->rdyNextPtr == NULL)
+	{
+		return;
+	}
+
+	//ͷ
+	pRdyList->headPtr = headTask->rdyNextPtr;
+	pRdyList->headPtr->rdyPrevPtr = NULL;
+
+	//ҵĩβ
+	headTask->rdyNextPtr = NULL;
+	headTask->rdyPrevPtr = pRdyList->tailPtr;
+	pRdyList->tailPtr->rdyNextPtr = headTask;
+	pRdyList->tailPtr = headTask;
+
+	headTask->timeQuantaCtr = headTask->timeQuanta;
+}
+
+/*********************************************************************************************************
+* : OS_SchedRoundRobin
+* : ǰʱƬ תͬȼбĩβ
+* : void
+* : void
+*   ֵ: void
+* : 20260206
+* ע    : 
+*           (1) û  SysTick_Handler  OS_TickUpdate ֮  OS_Sched л
+*           (2) ֻеǰǾбͷҴͬȼʱʱƬ
+*********************************************************************************************************/
+void OS_SchedRoundRobin(void)
+{
+	OS_TASK_HANDLE *p_tcb;
+
+	p_tcb = g_pCurrentTask;
+	if(p_tcb == NULL || s_OSRdyLists[p_tcb->priority].headPtr != p_tcb || p_tcb->rdyNextPtr == NULL)
+	{
+		return;
+	}
+
+	if(p_tcb->timeQuantaCtr > 1)
+	{
+		p_tcb->timeQuantaCtr--;
+		return;
+	}
+
+	OS_RdyListRotate(p_tcb->priority);
+}
+
+/*********************************************************************************************************
+* : OSYield
+* : ǰʣʱƬ ͬȼһ
+* : void
+* : void
+*   ֵ: void
+* : 20260206
+* ע    : ûͬȼʱֱӷ øȼ
+*********************************************************************************************************/
+void OSYield(void)
+{
+	OS_TASK_HANDLE *p_tcb;
+
+	OS_ENTER_CRITICAL();
+	p_tcb = g_pCurrentTask;
+	if(s_OSRdyLists[p_tcb->priority].headPtr != p_tcb || p_tcb->rdyNextPtr == NULL)
+	{
+		OS_EXIT_CRITICAL();
+		return;
+	}
+	OS_RdyListRotate(p_tcb->priority);
+	OS_EXIT_CRITICAL();
+
+	OS_Sched();
+}
+
+/*********************************************************************************************************
+* : OSTaskSetTimeQuanta
+* : ʱƬ
+* : p_tcb:  quanta: ʱƬ(tick) 0ʾʹ OS_CFG_TIME_QUANTA_DEFAULT
+* : void
+*   ֵ: void
+* : 20260206
+* ע    :  OSRegister ֮OSStart ֮ǰ ³ȴһʱƬʼЧ
+*********************************************************************************************************/
+void OSTaskSetTimeQuanta(OS_TASK_HANDLE *p_tcb, u32 quanta)
+{
+	if(p_tcb == NULL)
+	{
+		printf("ERROR:[OSTaskSetTimeQuanta] Handle Is Null!\r\n");
+		return;
+	}
+
+	if(quanta == 0)
+	{
+		quanta = OS_CFG_TIME_QUANTA_DEFAULT;
+	}
+
+	OS_ENTER_CRITICAL();
+	p_tcb->timeQuanta = quanta;
+	OS_EXIT_CRITICAL();
+}
+#endif	//OS_CFG_SCHED_RR_EN
+
+#if OS_CFG_TICK_WHEEL_EN != 0
+/*********************************************************************************************************
+* : OS_TickWheelExpire
+* : ʱĳѵڵ
+* : slot: ±
+* : void
+*   ֵ: void
+* : 20260209
+* ע    : ڻеʱںȦ ֻ tick ڵǰļ
+*********************************************************************************************************/
+static void OS_TickWheelExpire(u32 slot)
+{
+	OS_TASK_HANDLE *p_tcb;
+	OS_TASK_HANDLE *p_tcb_next;
+
+	p_tcb = s_OSTickWheel[slot];
+	while(p_tcb != NULL)
+	{
+		p_tcb_next = p_tcb->tickNextPtr;	//ڴƳ ȱ
+		if(p_tcb->tick <= s_OSTickCnt)
+		{
+			OS_TickTaskExpire(p_tcb);
+		}
+		p_tcb = p_tcb_next;
+	}
 }
 
 /*********************************************************************************************************
-* : OS_TaskListInit
-* : ʼȫб
+* : OS_TickListInit
+* : ʼʱб(ʱ)
 * : void
 * : void
 *   ֵ: void
-* : 20260122
+* : 20260209
 * ע    : û ںʹ
 *********************************************************************************************************/
-void OS_TaskListInit(void)
+void OS_TickListInit(void)
 {
-	//ڱ(head) 洢ʵ
-	g_OSTaskListHead.nextPtr = NULL;
+	u32 i;
+
+	for(i = 0; i < OS_CFG_TICK_WHEEL_SIZE; i++)
+	{
+		s_OSTickWheel[i] = NULL;
+	}
+	s_OSTickWheelCnt = 0;
+	s_OSTickCnt = 0;
 }
 
 /*********************************************************************************************************
-* : OS_TaskListInit
-* : ȫбĩβ
-* : void
+* : OS_TickTaskInsert
+* : յʱ̲ʱ
+* :  ʱʱ
 * : void
 *   ֵ: void
-* : 20260122
-* ע    : û ںʹ
-*						ȣOS_TaskFind/ͳ
+* : 20260209
+* ע    : û ͷ嵽ʱ̶ӦĲ O(1)
 *********************************************************************************************************/
-void OS_TaskListAdd(OS_TASK_HANDLE *p_tcb)
+void OS_TickTaskInsert(OS_TASK_HANDLE *p_tcb, u64 time)
 {
-	OS_TASK_HANDLE* pCurrTask;	//
-	
+	u32 slot;
+
 	//
 	if(p_tcb == NULL)
 	{
 		return;
 	}
-	
-	pCurrTask = &g_OSTaskListHead;
-	while(pCurrTask->nextPtr != NULL)
+	if(time == 0)	//ʱ Ӧüб
 	{
-		pCurrTask = pCurrTask->nextPtr;
+		OS_RdyTaskAdd(p_tcb);
+		return;
 	}
-	pCurrTask->nextPtr = p_tcb;
-	p_tcb->nextPtr = NULL;
+
+	p_tcb->tick = s_OSTickCnt + time;
+	slot = (u32)(p_tcb->tick & OS_TICK_WHEEL_MASK);
+
+	p_tcb->tickPrevPtr = NULL;
+	p_tcb->tickNextPtr = s_OSTickWheel[slot];
+	if(s_OSTickWheel[slot] != NULL)
+	{
+		s_OSTickWheel[slot]->tickPrevPtr = p_tcb;
+	}
+	s_OSTickWheel[slot] = p_tcb;
+	s_OSTickWheelCnt++;
 }
 
 /*********************************************************************************************************
-* : OS_TaskListRemove
-* : ȫбɾ
-* : void
+* : OS_TickTaskRemove
+* : ʱɾĳ
+* : 
 * : void
 *   ֵ: void
-* : 20260122
-* ע    : û ںʹ
-*						ȣOS_TaskFind/ͳ
+* : 20260209
+* ע    : û O(1)
 *********************************************************************************************************/
-void OS_TaskListRemove(OS_TASK_HANDLE *p_tcb)
+void OS_TickTaskRemove(OS_TASK_HANDLE *p_tcb)
 {
-	OS_TASK_HANDLE* pPrevTask;	//Ҫɾǰ
-	OS_TASK_HANDLE* pCurrTask;	//Ҫɾ
-	
-	//
 	if(p_tcb == NULL)
 	{
+		printf("Warning: Try to remove a NULL Task!\r\n");
 		return;
 	}
-	
-	pPrevTask = &g_OSTaskListHead;
-	while(pPrevTask->nextPtr != NULL)
+
+	if(p_tcb->tickPrevPtr == NULL)	//ͷ
 	{
-		if(pPrevTask->nextPtr == p_tcb)	//ҵǰ
-		{
-			//ӵɾ
-			pCurrTask = pPrevTask->nextPtr;
-			pPrevTask->nextPtr = pCurrTask->nextPtr;
-			pCurrTask->nextPtr = NULL;
-			return;
-		}
-		pCurrTask = pCurrTask->nextPtr;
+		s_OSTickWheel[p_tcb->tick & OS_TICK_WHEEL_MASK] = p_tcb->tickNextPtr;
 	}
-	
-	//ûҵ
-	printf("Warning: Cannot Find Task!\r\n");
+	else
+	{
+		p_tcb->tickPrevPtr->tickNextPtr = p_tcb->tickNextPtr;
+	}
+	if(p_tcb->tickNextPtr != NULL)
+	{
+		p_tcb->tickNextPtr->tickPrevPtr = p_tcb->tickPrevPtr;
+	}
+
+	p_tcb->tickPrevPtr = NULL;
+	p_tcb->tickNextPtr = NULL;
+	p_tcb->tick = 0;
+	s_OSTickWheelCnt--;
 }
 
 /*********************************************************************************************************
-* : OS_RdyListInit
-* : ʼоб
+* : OS_TickUpdate
+* : ʱж ǰĶӦĲ
 * : void
 * : void
 *   ֵ: void
-* : 20260122
+* : 20260209
 * ע    : û ںʹ
 *********************************************************************************************************/
-void OS_RdyListInit(void)
+void OS_TickUpdate(void)
 {
-	u8 i;
+	s_OSTickCnt++;
+#if OS_CFG_TASK_PROFILE_EN != 0
+	if((s_OSTickCnt & (OS_RUNTIME_SYNC_TICKS - 1)) == 0)
+	{
+		OS_TaskRunTimeUpdate();	//нĲ PendSV ڲ ֹʱ
+	}
+#endif
 
-	for (i = 0; i < OS_CFG_PRIO_MAX; i++)
+	if(s_OSTickWheelCnt == 0)	//ûʱ
 	{
-		s_OSRdyLists[i].headPtr = NULL;
-		s_OSRdyLists[i].tailPtr = NULL;
+		return;
 	}
+
+	OS_TickWheelExpire((u32)(s_OSTickCnt & OS_TICK_WHEEL_MASK));
 }
 
 /*********************************************************************************************************
-* : OS_RdyTaskAdd
-* : ھбмһĩβ
-* : 
+* : OS_TickUpdateBatch
+* : һԲǶ ڼ䵽ڵʱ
+* : ticks: ҪǵĽ
 * : void
 *   ֵ: void
-* : 20260122
-* ע    : ֻܼ뵽ĳбĩβ ͬȼѭFCFSԭ
+* : 20260209
+* ע    : 
+*           (1) û tickless ģʽɿڻѺ ٽڵ
+*           (2) ǽĲһȦʱֱɨȫ ĴĲ
 *********************************************************************************************************/
-void OS_RdyTaskAdd(OS_TASK_HANDLE *p_tcb)
+void OS_TickUpdateBatch(u32 ticks)
 {
-	OS_RDY_LIST *pRdyList;
-	u32 prio;
+	u32 i;
 
-	//
-	if(p_tcb == NULL)
+#if OS_CFG_TASK_PROFILE_EN != 0
+	OS_TaskRunTimeUpdate();	//ڼûо PendSV ȼ
+#endif
+
+	if(ticks >= OS_CFG_TICK_WHEEL_SIZE)
 	{
+		s_OSTickCnt += ticks;
+		for(i = 0; i < OS_CFG_TICK_WHEEL_SIZE && s_OSTickWheelCnt != 0; i++)
+		{
+			OS_TickWheelExpire(i);
+		}
 		return;
 	}
 
-	//ӾбҵӦȼľб
-	prio = p_tcb->priority;
-	pRdyList = &s_OSRdyLists[prio];
-
-	//뵽ĩβ
-	p_tcb->rdyNextPtr = NULL;
-	if(pRdyList->headPtr == NULL)	//þб
-	{
-		p_tcb->rdyPrevPtr = NULL;
-		pRdyList->headPtr = p_tcb;
-	}
-	else	//þбǿ
+	for(i = 0; i < ticks; i++)
 	{
-		p_tcb->rdyPrevPtr = pRdyList->tailPtr;
-		pRdyList->tailPtr->rdyNextPtr = p_tcb;
+		s_OSTickCnt++;
+		if(s_OSTickWheelCnt != 0)
+		{
+			OS_TickWheelExpire((u32)(s_OSTickCnt & OS_TICK_WHEEL_MASK));
+		}
 	}
-	pRdyList->tailPtr = p_tcb;	//ĸ βָ붼ָ¼ӽ
-
-	//λͼ λбȼλͼ
-	OS_BitMapSet(prio);
 }
 
 /*********************************************************************************************************
-* : OS_RdyTaskRemove
-* : ӾбƳ
-* : 
+* : OS_TickGetNextWakeup
+* : ȡһʱڻжٽ
+* : void
 * : void
-*   ֵ: void
-* : 20260122
-* ע    : ܴбλɾ
-						û ںʹ
+*   ֵ: ڵĽ 0ʾǰûʱ
+* : 20260209
+* ע    : 
+*           (1) û  tickless ǰ
+*           (2) ʱһȦ ڵʱǡΪȦΪ
+*               һȦڶûںȦ ȫȡСֵ
 *********************************************************************************************************/
-void OS_RdyTaskRemove(OS_TASK_HANDLE *p_tcb)
+u64 OS_TickGetNextWakeup(void)
 {
-	OS_RDY_LIST *pRdyList;
-	u32 prio;
+	OS_TASK_HANDLE *p_tcb;
+	u64 expire;
+	u64 nearest;
+	u32 i;
 
-	//
-	if(p_tcb == NULL)
+	if(s_OSTickWheelCnt == 0)
 	{
-		return;
+		return 0;
 	}
 
-	//ӾбҵӦȼľб
-	prio = p_tcb->priority;
-	pRdyList = &s_OSRdyLists[prio];
-
-	//бͷƳ
-	if(p_tcb->rdyPrevPtr == NULL)	//ͷ
+	for(i = 1; i <= OS_CFG_TICK_WHEEL_SIZE; i++)
 	{
-		pRdyList->headPtr = p_tcb->rdyNextPtr;	//бͷָָһ
-		if(p_tcb->rdyNextPtr != NULL)	//滹н
+		expire = s_OSTickCnt + i;
+		for(p_tcb = s_OSTickWheel[expire & OS_TICK_WHEEL_MASK]; p_tcb != NULL; p_tcb = p_tcb->tickNextPtr)
 		{
-			p_tcb->rdyNextPtr->rdyPrevPtr = NULL;	//һͷ
+			if(p_tcb->tick == expire)
+			{
+				return i;
+			}
 		}
 	}
-	else if(p_tcb->rdyNextPtr == NULL)//β
-	{
-		pRdyList->tailPtr = p_tcb->rdyPrevPtr;	//бβָָһ
-		p_tcb->rdyPrevPtr->rdyNextPtr = NULL;	//һβ
-	}
-	else	//м
-	{
-		p_tcb->rdyPrevPtr->rdyNextPtr = p_tcb->rdyNextPtr;
-		p_tcb->rdyNextPtr->rdyPrevPtr = p_tcb->rdyPrevPtr;
-	}
-	
-	p_tcb->rdyNextPtr = NULL;
-	p_tcb->rdyPrevPtr = NULL;
 
-	//λͼ þбѾû
-	if(pRdyList->headPtr == NULL)
+	nearest = (u64)-1;
+	for(i = 0; i < OS_CFG_TICK_WHEEL_SIZE; i++)
 	{
-		OS_BitMapClr(prio);
+		for(p_tcb = s_OSTickWheel[i]; p_tcb != NULL; p_tcb = p_tcb->tickNextPtr)
+		{
+			if(p_tcb->tick < nearest)
+			{
+				nearest = p_tcb->tick;
+			}
+		}
 	}
+	return nearest - s_OSTickCnt;
 }
 
+#else	//OS_CFG_TICK_WHEEL_EN
 /*********************************************************************************************************
 * : OS_TickListInit
 * : ھбмһĩβ
@@ -416,6 +1480,7 @@ void OS_TickListInit(void)
 {
 	s_OSTickList.headPtr = NULL;
 	s_OSTickList.tailPtr = NULL;
+	s_OSTickCnt = 0;
 }
 
 /*********************************************************************************************************
@@ -578,6 +1643,14 @@ void OS_TickUpdate(void)
 {
 	OS_TASK_HANDLE *headTask = NULL;
 	
+	s_OSTickCnt++;
+#if OS_CFG_TASK_PROFILE_EN != 0
+	if((s_OSTickCnt & (OS_RUNTIME_SYNC_TICKS - 1)) == 0)
+	{
+		OS_TaskRunTimeUpdate();	//нĲ PendSV ڲ ֹʱ
+	}
+#endif
+	
 	headTask = s_OSTickList.headPtr;
 	if(headTask == NULL)	//ûʱ
 	{
@@ -589,10 +1662,99 @@ void OS_TickUpdate(void)
 	
 	while(headTask != NULL && headTask->tick == 0)
 	{
-		OS_TickTaskRemove(headTask);
-		OS_RdyTaskAdd(headTask);
+		OS_TickTaskExpire(headTask);
+		headTask = s_OSTickList.headPtr;	//»ȡµͷڵ
+	}
+}
+
+/*********************************************************************************************************
+* : OS_TickUpdateBatch
+* : һԲǶ ڼ䵽ڵʱ
+* : ticks: ҪǵĽ
+* : void
+*   ֵ: void
+* : 20260205
+* ע    : 
+*           (1) û tickless ģʽɿڻѺ ٽڵ
+*           (2) бֻرͷۼ б ʣļǵ±ͷ
+*********************************************************************************************************/
+void OS_TickUpdateBatch(u32 ticks)
+{
+	OS_TASK_HANDLE *headTask = NULL;
+	
+#if OS_CFG_TASK_PROFILE_EN != 0
+	OS_TaskRunTimeUpdate();	//ڼûо PendSV ȼ
+#endif
+	s_OSTickCnt += ticks;
+	
+	headTask = s_OSTickList.headPtr;
+	while(headTask != NULL && headTask->tick <= ticks)
+	{
+		ticks -= (u32)headTask->tick;
+		headTask->tick = 0;
+		OS_TickTaskExpire(headTask);
 		headTask = s_OSTickList.headPtr;	//»ȡµͷڵ
 	}
+	
+	if(headTask != NULL)
+	{
+		headTask->tick -= ticks;
+	}
+}
+
+/*********************************************************************************************************
+* : OS_TickGetNextWakeup
+* : ȡһʱڻжٽ
+* : void
+* : void
+*   ֵ: ͷtick 0ʾǰûʱ
+* : 20260205
+* ע    : û бͷtickΪĵʱ O(1)
+*********************************************************************************************************/
+u64 OS_TickGetNextWakeup(void)
+{
+	if(s_OSTickList.headPtr == NULL)
+	{
+		return 0;
+	}
+	return s_OSTickList.headPtr->tick;
+}
+
+#endif	//OS_CFG_TICK_WHEEL_EN
+
+/*********************************************************************************************************
+* : OS_TickCntGet
+* : ȡϵͳļ
+* : void
+* : void
+*   ֵ: ϵͳļ
+* : 20260210
+* ע    : û ٽ Ѵٽж(64λζȡ) ʡȥǶٽĿ
+*           жȡʹ OSTimeGet
+*********************************************************************************************************/
+u64 OS_TickCntGet(void)
+{
+	return s_OSTickCnt;
+}
+
+/*********************************************************************************************************
+* : OSTimeGet
+* : ȡϵͳĽ
+* : void
+* : void
+*   ֵ: ϵͳļ(1 tick = 1ms)
+* : 20260205
+* ע    : tickless ģʽڼĽڻʱһԲ 
+*********************************************************************************************************/
+u64 OSTimeGet(void)
+{
+	u64 ticks;
+	
+	OS_ENTER_CRITICAL();
+	ticks = s_OSTickCnt;
+	OS_EXIT_CRITICAL();
+	
+	return ticks;
 }
 
 /*********************************************************************************************************
@@ -606,7 +1768,17 @@ void OS_TickUpdate(void)
 *********************************************************************************************************/
 void OS_BitMapInit(void)
 {
+#if OS_CFG_PRIO_MAX <= 32
 	s_OSPrioBitMap = (u32)0;
+#else
+	u32 i;
+
+	s_OSPrioGrpMap = (u32)0;
+	for(i = 0; i < OS_PRIO_GRP_NUM; i++)
+	{
+		s_OSPrioBitMap[i] = (u32)0;
+	}
+#endif
 }
 
 /*********************************************************************************************************
@@ -625,8 +1797,13 @@ void OS_BitMapSet(u32 prio)
 		printf("ERROR: [OS_BitMapSet] Illegal Argument!\r\n");
 		return;
 	}
+#if OS_CFG_PRIO_MAX <= 32
 	prio = 31 - prio;
 	s_OSPrioBitMap |= (1 << prio);
+#else
+	s_OSPrioBitMap[prio >> 5] |= ((u32)1 << (31 - (prio & 0x1F)));
+	s_OSPrioGrpMap |= ((u32)1 << (31 - (prio >> 5)));
+#endif
 }
 
 /*********************************************************************************************************
@@ -645,8 +1822,16 @@ void OS_BitMapClr(u32 prio)
 		printf("ERROR: [OS_BitMapSet] Illegal Argument!\r\n");
 		return;
 	}
+#if OS_CFG_PRIO_MAX <= 32
 	prio = 31 - prio;
 	s_OSPrioBitMap &= ~(1 << prio);
+#else
+	s_OSPrioBitMap[prio >> 5] &= ~((u32)1 << (31 - (prio & 0x1F)));
+	if(s_OSPrioBitMap[prio >> 5] == (u32)0)	//޾ λ
+	{
+		s_OSPrioGrpMap &= ~((u32)1 << (31 - (prio >> 5)));
+	}
+#endif
 }
 
 /*********************************************************************************************************
@@ -660,6 +1845,7 @@ void OS_BitMapClr(u32 prio)
 *********************************************************************************************************/
 u32 OS_BitMapGetHighest(void)
 {
+#if OS_CFG_PRIO_MAX <= 32
 	if(s_OSPrioBitMap == (u32)0)
 	{
 		printf("ERROR: [OS_BitMapGetHighest] No Ready Task!\r\n");
@@ -667,6 +1853,18 @@ u32 OS_BitMapGetHighest(void)
 	}
 	
 	return __builtin_clz(s_OSPrioBitMap);
+#else
+	u32 grp;
+	
+	if(s_OSPrioGrpMap == (u32)0)
+	{
+		printf("ERROR: [OS_BitMapGetHighest] No Ready Task!\r\n");
+		while(1){}	//ûо, ס
+	}
+	
+	grp = __builtin_clz(s_OSPrioGrpMap);	//ȼ ڲ
+	return (grp << 5) + __builtin_clz(s_OSPrioBitMap[grp]);
+#endif
 }
 
 /*********************************************************************************************************
@@ -830,7 +2028,7 @@ void OS_PendListPopAlltoRdyList(OS_PEND_LIST *p_pend_list)
 	{
 		p_tcb_next = p_tcb->pendNextPtr;
 		OS_PendListRemove(p_pend_list, p_tcb);
-		OS_RdyTaskAdd(p_tcb);
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
 		p_tcb = p_tcb_next;
 	}
 }
@@ -849,3 +2047,85 @@ OS_TASK_HANDLE* OS_PendListGetHighest(OS_PEND_LIST *p_pend_list)
 {
 	return (p_pend_list != NULL) ? p_pend_list->headPtr : NULL;
 }
+
+/*********************************************************************************************************
+* : OS_ObjPendListGet
+* : ȡں˶Ĺб
+* : p_obj:  pendObj ָں˶
+* : void
+*   ֵ: бָ ûйб(ڽϢ)ʱNULL
+* : 20260208
+* ע    : û ں˶ĵһԱ objType
+*********************************************************************************************************/
+OS_PEND_LIST* OS_ObjPendListGet(void *p_obj)
+{
+	switch(*(OS_OBJ_TYPE*)p_obj)
+	{
+#if OS_CFG_SEM_EN != 0
+		case OS_OBJ_TYPE_SEM:		return &((OS_SEM*)p_obj)->pendList;
+#endif
+#if OS_CFG_MUTEX_EN != 0
+		case OS_OBJ_TYPE_MUTEX:	return &((OS_MUTEX*)p_obj)->pendList;
+#endif
+#if OS_CFG_FLAG_EN != 0
+		case OS_OBJ_TYPE_FLAG:	return &((OS_FLAG*)p_obj)->pendList;
+#endif
+#if OS_CFG_MEM_PART_EN != 0
+		case OS_OBJ_TYPE_MEM_PART:	return &((OS_MEM_PART*)p_obj)->pendList;
+#endif
+		default:								return NULL;
+	}
+}
+
+/*********************************************************************************************************
+* : OS_PendTaskBlock
+* : ǰȴĳں˶
+* : p_pend_list: б(ΪNULL) p_obj: ȴĶ timeout: ʱ 0ʾõȴ
+* : void
+*   ֵ: void
+* : 20260208
+* ע    : 
+*           (1) û ٽڵ ˳ٽɵߴ
+*           (2) timeout Ϊ0ʱͬʱʱб  OS_TickUpdate ȴ
+*********************************************************************************************************/
+void OS_PendTaskBlock(OS_PEND_LIST *p_pend_list, void *p_obj, u32 timeout)
+{
+	OS_RdyTaskRemove(g_pCurrentTask);
+	if(p_pend_list != NULL)
+	{
+		OS_PendListInsert(p_pend_list, g_pCurrentTask);
+	}
+	g_pCurrentTask->state = OS_TASK_PEND;
+	g_pCurrentTask->pendObj = p_obj;
+	g_pCurrentTask->pendStat = OS_PEND_OK;
+
+	if(timeout != OS_WAIT_FOREVER)
+	{
+		g_pCurrentTask->tick = timeout;
+		OS_TickTaskInsert(g_pCurrentTask, timeout);
+	}
+}
+
+/*********************************************************************************************************
+* : OS_PendTaskReady
+* : ĵȴ״̬б
+* : p_tcb:  stat: ȴ
+* : void
+*   ֵ: void
+* : 20260208
+* ע    : 
+*           (1) û ٽڵ ǰȽƳб
+*           (2) ʱȴͬʱʱб ڴһƳ
+*           (3) ȴڼ䱻õ󱣳ֹ б
+*********************************************************************************************************/
+void OS_PendTaskReady(OS_TASK_HANDLE *p_tcb, OS_PEND_STAT stat)
+{
+	OS_TRACE(OS_TRACE_TASK_READY, p_tcb->pendObj, ((u16)stat << 8) | p_tcb->traceId);
+	if(OS_TickTaskIsIn(p_tcb))
+	{
+		OS_TickTaskRemove(p_tcb);
+	}
+	p_tcb->pendObj = NULL;
+	p_tcb->pendStat = stat;
+	OS_TaskWaitEnd(p_tcb);
+}
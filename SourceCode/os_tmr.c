@@ -0,0 +1,400 @@
+/*********************************************************************************************************
+* ģƣos_tmr.c
+* ժ    Ҫʱ
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260210
+*     ݣ
+*           (1) ṩ(ONE_SHOT)(PERIODIC)ʱ
+*           (2) еĶʱԵʱڶʱ
+*           (3) SysTick ֻͷǷڣںѶʱ񣬻صͳһڷִ
+* ע    ⣺
+*           (1) жʱص÷ջصвûĽӿ(Pend/Delay)
+*           (2) OSTmrCreate/Start/Stop/Reset ֻٽڲжоɵ
+*           (3) ڶʱʱۼڣصִʱƯƣ񱻳ʱʱ
+*           (4) ʹڽźȴѣҪʹ OS_CFG_SEM_EN
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+
+#if OS_CFG_TMR_EN != 0
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#if OS_CFG_SEM_EN == 0
+#error "OS_CFG_TMR_EN requires OS_CFG_SEM_EN"
+#endif
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static OS_TMR*        s_OSTmrListHead;												//еĶʱ(ʱ)
+static u32            s_arrTmrStack[OS_CFG_TMR_TASK_STK_SIZE];	//ʱջ
+static OS_TASK_HANDLE s_structTmrHandle;											//ʱ
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static void OS_TmrListInsert(OS_TMR *p_tmr);	//ʱ̲붨ʱ
+static void OS_TmrListRemove(OS_TMR *p_tmr);	//ӶʱƳ
+static void OS_TmrTask(void);									//ʱ
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_TmrListInsert
+* ܣʱ̲붨ʱ
+* p_tmr: ʱָ(expire )
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ٽڵ ʱͬĶʱ˳
+*********************************************************************************************************/
+static void OS_TmrListInsert(OS_TMR *p_tmr)
+{
+	OS_TMR *p_cur;
+	OS_TMR *p_prev;
+
+	p_prev = NULL;
+	p_cur = s_OSTmrListHead;
+	while(p_cur != NULL && p_cur->expire <= p_tmr->expire)
+	{
+		p_prev = p_cur;
+		p_cur = p_cur->nextPtr;
+	}
+
+	p_tmr->prevPtr = p_prev;
+	p_tmr->nextPtr = p_cur;
+	if(p_cur != NULL)
+	{
+		p_cur->prevPtr = p_tmr;
+	}
+	if(p_prev == NULL)	//ڱͷ
+	{
+		s_OSTmrListHead = p_tmr;
+	}
+	else
+	{
+		p_prev->nextPtr = p_tmr;
+	}
+	p_tmr->state = OS_TMR_STATE_RUNNING;
+}
+
+/*********************************************************************************************************
+* ƣOS_TmrListRemove
+* ܣӶʱƳ
+* p_tmr: ʱָ(봦 RUNNING ״̬)
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ٽڵ ޸Ķʱ״̬ ɵ
+*********************************************************************************************************/
+static void OS_TmrListRemove(OS_TMR *p_tmr)
+{
+	if(p_tmr->prevPtr == NULL)	//ͷ
+	{
+		s_OSTmrListHead = p_tmr->nextPtr;
+	}
+	else
+	{
+		p_tmr->prevPtr->nextPtr = p_tmr->nextPtr;
+	}
+	if(p_tmr->nextPtr != NULL)
+	{
+		p_tmr->nextPtr->prevPtr = p_tmr->prevPtr;
+	}
+	p_tmr->prevPtr = NULL;
+	p_tmr->nextPtr = NULL;
+}
+
+/*********************************************************************************************************
+* ƣOS_TmrTask
+* ܣʱ ִѵڶʱĻص
+* void
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺
+*           (1) ÿֻٽȡһڶʱװصٽִ
+*           (2) ڶʱװٻصصп԰ȫ Stop/Reset Լ
+*********************************************************************************************************/
+static void OS_TmrTask(void)
+{
+	OS_TMR *p_tmr;
+	OS_TMR_CALLBACK callback;
+	void *p_arg;
+	u64 now;
+
+	while(1)
+	{
+		OSSemPend(&s_structTmrHandle.sem);	//ȴ SysTick ֱͷ
+
+		while(1)
+		{
+			now = OSTimeGet();
+
+			OS_ENTER_CRITICAL();
+			p_tmr = s_OSTmrListHead;
+			if(p_tmr == NULL || p_tmr->expire > now)	//ûеڵĶʱ
+			{
+				OS_EXIT_CRITICAL();
+				break;
+			}
+
+			OS_TmrListRemove(p_tmr);
+			if(p_tmr->opt == OS_TMR_OPT_PERIODIC)
+			{
+				//ۼӵʱ ֱ
+				p_tmr->expire += ((now - p_tmr->expire) / p_tmr->period + 1) * p_tmr->period;
+				OS_TmrListInsert(p_tmr);
+			}
+			else
+			{
+				p_tmr->state = OS_TMR_STATE_COMPLETED;
+			}
+			callback = p_tmr->callback;
+			p_arg = p_tmr->p_arg;
+			OS_EXIT_CRITICAL();
+
+			callback(p_tmr, p_arg);
+		}
+	}
+}
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_TmrInit
+* ܣʼʱעᶨʱ
+* void
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺û  InitCasyOS ģʼ֮
+*********************************************************************************************************/
+void OS_TmrInit(void)
+{
+	s_OSTmrListHead = NULL;
+	OSRegister(&s_structTmrHandle, OS_TmrTask, "TmrTask", OS_CFG_TMR_TASK_PRIO, s_arrTmrStack, OS_CFG_TMR_TASK_STK_SIZE, 1, 0);
+}
+
+/*********************************************************************************************************
+* ƣOS_TmrTickUpdate
+* ܣĴ ͷʱʱѶʱ
+* void
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺
+*           (1) û  SysTick_Handler  tickless ǽĺ O(1)
+*           (2) tickless ʱڿٽڣﲻܵ OSSemPost(˳ٽ)
+*               ֱڽźͷţ SysTick 
+*********************************************************************************************************/
+void OS_TmrTickUpdate(void)
+{
+	OS_SEM *p_sem;
+	OS_TASK_HANDLE *p_tcb;
+
+	if(s_OSTmrListHead == NULL || s_OSTmrListHead->expire > OS_TickCntGet())
+	{
+		return;
+	}
+
+	p_sem = &s_structTmrHandle.sem;
+	p_tcb = OS_PendListGetHighest(&p_sem->pendList);
+	if(p_tcb != NULL)
+	{
+		OS_PendListRemove(&p_sem->pendList, p_tcb);
+		OS_PendTaskReady(p_tcb, OS_PEND_OK);
+	}
+	else
+	{
+		p_sem->count = p_sem->countMax;	//ڴ һλѼ
+	}
+}
+
+/*********************************************************************************************************
+* ƣOS_TmrGetNextWakeup
+* ܣȡһʱڻжٽ
+* void
+* void
+*   ֵڵĽ 0ʾǰûеĶʱ
+* ڣ20260210
+* ע    ⣺û tickless ģʽɿٽڵ
+*********************************************************************************************************/
+u64 OS_TmrGetNextWakeup(void)
+{
+	u64 now;
+
+	if(s_OSTmrListHead == NULL)
+	{
+		return 0;
+	}
+
+	now = OS_TickCntGet();
+	if(s_OSTmrListHead->expire <= now)	//ѵ δ
+	{
+		return 1;
+	}
+	return s_OSTmrListHead->expire - now;
+}
+
+/*********************************************************************************************************
+* ƣOSTmrCreate
+* ܣʱ
+* p_tmr: ʱָ p_name: ʱ
+*           delay: ״εڵĽ 0ʾʹ period
+*           period: ڽ(ڶʱʹ)
+*           opt: OS_TMR_OPT_ONE_SHOT / OS_TMR_OPT_PERIODIC
+*           callback: ڻص p_arg: ص
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ STOPPED ״̬  OSTmrStart 
+*********************************************************************************************************/
+void OSTmrCreate(OS_TMR *p_tmr, u8 *p_name, u32 delay, u32 period, OS_TMR_OPT opt, OS_TMR_CALLBACK callback, void *p_arg)
+{
+	if(p_tmr == NULL || callback == NULL)
+	{
+		printf("ERROR:[OSTmrCreate] Illegal argument!\r\n");
+		return;
+	}
+	if((opt == OS_TMR_OPT_PERIODIC && period == 0) || (opt == OS_TMR_OPT_ONE_SHOT && delay == 0))
+	{
+		printf("ERROR:[OSTmrCreate] Illegal time!\r\n");
+		return;
+	}
+
+	OS_ENTER_CRITICAL();
+	p_tmr->objType  = OS_OBJ_TYPE_TMR;
+	p_tmr->name     = p_name;
+	p_tmr->delay    = (delay == 0) ? period : delay;
+	p_tmr->period   = period;
+	p_tmr->opt      = opt;
+	p_tmr->callback = callback;
+	p_tmr->p_arg    = p_arg;
+	p_tmr->state    = OS_TMR_STATE_STOPPED;
+	p_tmr->expire   = 0;
+	p_tmr->nextPtr  = NULL;
+	p_tmr->prevPtr  = NULL;
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSTmrStart
+* ܣʱ
+* p_tmr: ʱָ
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ӵʱ̿ʼʱ delay ĺ״εڣеĶʱӰ(¼ʱ OSTmrReset)
+*********************************************************************************************************/
+void OSTmrStart(OS_TMR *p_tmr)
+{
+	OS_ENTER_CRITICAL();
+
+	if(p_tmr == NULL || p_tmr->objType != OS_OBJ_TYPE_TMR)
+	{
+		printf("ERROR:[OSTmrStart] Illegal argument!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	if(p_tmr->state != OS_TMR_STATE_RUNNING)
+	{
+		p_tmr->expire = OS_TickCntGet() + p_tmr->delay;
+		OS_TmrListInsert(p_tmr);
+	}
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSTmrStop
+* ܣֹͣʱ
+* p_tmr: ʱָ
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺ѵڵصδִеĵζʱִлص
+*********************************************************************************************************/
+void OSTmrStop(OS_TMR *p_tmr)
+{
+	OS_ENTER_CRITICAL();
+
+	if(p_tmr == NULL || p_tmr->objType != OS_OBJ_TYPE_TMR)
+	{
+		printf("ERROR:[OSTmrStop] Illegal argument!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	if(p_tmr->state == OS_TMR_STATE_RUNNING)
+	{
+		OS_TmrListRemove(p_tmr);
+	}
+	p_tmr->state = OS_TMR_STATE_STOPPED;
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSTmrReset
+* ܣ¿ʼʱ
+* p_tmr: ʱָ
+* void
+*   ֵvoid
+* ڣ20260210
+* ע    ⣺۵ǰ״̬ ӵʱ delay ĺ(Źʽĳʱ)
+*********************************************************************************************************/
+void OSTmrReset(OS_TMR *p_tmr)
+{
+	OS_ENTER_CRITICAL();
+
+	if(p_tmr == NULL || p_tmr->objType != OS_OBJ_TYPE_TMR)
+	{
+		printf("ERROR:[OSTmrReset] Illegal argument!\r\n");
+		OS_EXIT_CRITICAL();
+		return;
+	}
+
+	if(p_tmr->state == OS_TMR_STATE_RUNNING)
+	{
+		OS_TmrListRemove(p_tmr);
+	}
+	p_tmr->expire = OS_TickCntGet() + p_tmr->delay;
+	OS_TmrListInsert(p_tmr);
+
+	OS_EXIT_CRITICAL();
+}
+
+/*********************************************************************************************************
+* ƣOSTmrStateGet
+* ܣȡʱ״̬
+* p_tmr: ʱָ
+* void
+*   ֵOS_TMR_STATE_STOPPED / OS_TMR_STATE_RUNNING / OS_TMR_STATE_COMPLETED
+* ڣ20260210
+* ע    ⣺
+*********************************************************************************************************/
+OS_TMR_STATE OSTmrStateGet(OS_TMR *p_tmr)
+{
+	return p_tmr->state;
+}
+
+#endif	//OS_CFG_TMR_EN
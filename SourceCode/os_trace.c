@@ -0,0 +1,242 @@
+/*********************************************************************************************************
+* ģƣos_trace.c
+* ժ    Ҫں¼׷
+* ǰ汾1.0.0
+*     ߣChill
+* ڣ20260213
+*     ݣ
+*           (1) лжϽź/Ϣ//¼־ Post/Pend д RAM λ
+*           (2) ÿ¼ 12 ֽڣʱ + ַ + ¼ + ǰ + ¼
+*           (3) ̨ڵ OSTraceRead ȡ¼˽빤߻ԭʱ
+* ע    ⣺
+*           (1) OS_TraceRecord ٽ㴦ڵٽ( SysTick ж)֤
+*           (2) д󸲸ɵļ¼OSTraceRead ȡʱѱǵĲֲ붪ʧ
+*           (3) ʱֲ OS_PortTimestampGetCortex-M Ϊ DWT CYCCNT
+*           (4) ر OS_CFG_TRACE_EN ʱչΪգռκδ RAM
+**********************************************************************************************************
+* ȡ汾
+*     ߣ
+* ڣ
+* ޸ݣ
+* ޸ļ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ͷļ
+*********************************************************************************************************/
+#include "CasyOS.h"
+#include <stddef.h>
+
+#if OS_CFG_TRACE_EN != 0
+/*********************************************************************************************************
+*                                              궨
+*********************************************************************************************************/
+#if (OS_CFG_TRACE_BUF_SIZE & (OS_CFG_TRACE_BUF_SIZE - 1)) != 0
+#error "OS_CFG_TRACE_BUF_SIZE must be a power of 2"
+#endif
+
+#define OS_TRACE_BUF_MASK	(OS_CFG_TRACE_BUF_SIZE - 1)
+#define OS_TRACE_ID_WORDS	((OS_TRACE_ID_NONE + 31) / 32)	//λͼ
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+static OS_TRACE_REC s_arrTraceBuf[OS_CFG_TRACE_BUF_SIZE];	//׷ٻλ
+static u32          s_OSTraceHead;		//дļ¼( ȡλΪдλ)
+static u32          s_OSTraceTail;		//Ѷļ¼
+static u32          s_OSTraceLost;		//δļ¼
+static u32          s_arrTraceIdMap[OS_TRACE_ID_WORDS];	//λͼ λʾѷ
+extern OS_TASK_HANDLE* g_pCurrentTask;
+extern OS_TASK_HANDLE  g_OSTaskListHead;
+
+/*********************************************************************************************************
+*                                              ڲ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              öٽṹ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              ڲʵ
+*********************************************************************************************************/
+
+/*********************************************************************************************************
+*                                              APIʵ
+*********************************************************************************************************/
+/*********************************************************************************************************
+* ƣOS_TraceTaskIdAlloc
+* ܣΪע׷ٱ
+* void
+* void
+*   ֵ 󷵻 OS_TRACE_ID_NONE
+* ڣ20260213
+* ע    ⣺ OSRegister  СĿб ɾı OS_TraceTaskIdFree 黹
+*********************************************************************************************************/
+u8 OS_TraceTaskIdAlloc(void)
+{
+	u32 i;
+	u32 bit;
+	u32 id = OS_TRACE_ID_NONE;
+
+	OS_ENTER_CRITICAL();
+	for(i = 0; i < OS_TRACE_ID_WORDS; i++)
+	{
+		if(s_arrTraceIdMap[i] != 0xFFFFFFFF)
+		{
+			for(bit = 0; (s_arrTraceIdMap[i] & ((u32)1 << bit)) != 0; bit++)
+			{
+			}
+			id = i * 32 + bit;
+			break;
+		}
+	}
+	if(id >= OS_TRACE_ID_NONE)
+	{
+		OS_EXIT_CRITICAL();
+		printf("Warning:[OS_TraceTaskIdAlloc] Too many tasks to trace!\r\n");
+		return OS_TRACE_ID_NONE;
+	}
+	s_arrTraceIdMap[i] |= (u32)1 << bit;
+	OS_EXIT_CRITICAL();
+
+	return (u8)id;
+}
+
+/*********************************************************************************************************
+* ƣOS_TraceTaskIdFree
+* ܣ黹ɾ׷ٱ
+* id: 
+* void
+*   ֵvoid
+* ڣ20260217
+* ע    ⣺ OSTaskDelete ٽڵ OS_TRACE_ID_NONE ֱӺ
+*********************************************************************************************************/
+void OS_TraceTaskIdFree(u8 id)
+{
+	if(id >= OS_TRACE_ID_NONE)
+	{
+		return;
+	}
+	s_arrTraceIdMap[id >> 5] &= ~((u32)1 << (id & 0x1F));
+}
+
+/*********************************************************************************************************
+* ƣOS_TraceRecord
+* ܣдһ׷ټ¼
+* event: ¼ p_obj: ַ arg: ¼
+* void
+*   ֵvoid
+* ڣ20260213
+* ע    ⣺
+*           (1) û ͨ OS_TRACE  ٽڵ
+*           (2) ֻһʱȡͼδ洢 κж ֤㿪ֻмʮ
+*           (3) ռдλ ʹٽ SysTick ·Ҳֻ𻵵¼
+*********************************************************************************************************/
+void OS_TraceRecord(u8 event, void *p_obj, u16 arg)
+{
+	OS_TRACE_REC *p_rec;
+
+	p_rec = &s_arrTraceBuf[s_OSTraceHead++ & OS_TRACE_BUF_MASK];
+	p_rec->timestamp = OS_PortTimestampGet();
+	p_rec->obj       = (u32)(size_t)p_obj;
+	p_rec->event     = event;
+	p_rec->taskId    = (g_pCurrentTask != NULL) ? g_pCurrentTask->traceId : OS_TRACE_ID_NONE;
+	p_rec->arg       = arg;
+}
+
+/*********************************************************************************************************
+* ƣOSTraceRead
+* ܣʱ˳ȡ׷ټ¼
+* p_buf:  maxNum: ȡ
+* p_buf: ȡļ¼
+*   ֵʵȡ 0ʾû¼¼
+* ڣ20260213
+* ע    ⣺
+*           (1) ȡڼж maxNum ˹жʱ ÿȡʮ ѭ0Ϊֹ
+*           (2) ϴζȡд볬 OS_CFG_TRACE_BUF_SIZE ʱ ɵĲѱ  OSTraceLostGet
+*********************************************************************************************************/
+u32 OSTraceRead(OS_TRACE_REC *p_buf, u32 maxNum)
+{
+	u32 num = 0;
+
+	if(p_buf == NULL)
+	{
+		printf("ERROR:[OSTraceRead] Illegal argument!\r\n");
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+
+	if(s_OSTraceHead - s_OSTraceTail > OS_CFG_TRACE_BUF_SIZE)
+	{
+		s_OSTraceLost += s_OSTraceHead - s_OSTraceTail - OS_CFG_TRACE_BUF_SIZE;
+		s_OSTraceTail = s_OSTraceHead - OS_CFG_TRACE_BUF_SIZE;
+	}
+
+	while(s_OSTraceTail != s_OSTraceHead && num < maxNum)
+	{
+		p_buf[num++] = s_arrTraceBuf[s_OSTraceTail++ & OS_TRACE_BUF_MASK];
+	}
+
+	OS_EXIT_CRITICAL();
+
+	return num;
+}
+
+/*********************************************************************************************************
+* ƣOSTraceLostGet
+* ܣȡ򻺳дǵļ¼
+* void
+* void
+*   ֵʧļ¼
+* ڣ20260213
+* ע    ⣺ʧ OSTraceRead ʱ Ϊ0˵Ƶʲ򻺳ƫС
+*********************************************************************************************************/
+u32 OSTraceLostGet(void)
+{
+	return s_OSTraceLost;
+}
+
+/*********************************************************************************************************
+* ƣOSTraceTaskTableGet
+* ܣƵĶӦ
+* p_tab:  maxNum: 
+* p_tab: 
+*   ֵд p_tab 
+* ڣ20260213
+* ע    ⣺
+*           (1) עʱ ڼ䲻ı עɺ󵼳һμ
+*           (2) ɾıŻ֮ע 贴ڼµ
+*********************************************************************************************************/
+u32 OSTraceTaskTableGet(OS_TRACE_TASK *p_tab, u32 maxNum)
+{
+	OS_TASK_HANDLE *p_tcb;
+	u32 num = 0;
+	u32 i;
+
+	if(p_tab == NULL)
+	{
+		printf("ERROR:[OSTraceTaskTableGet] Illegal argument!\r\n");
+		return 0;
+	}
+
+	OS_ENTER_CRITICAL();
+	for(p_tcb = g_OSTaskListHead.nextPtr; p_tcb != NULL && num < maxNum; p_tcb = p_tcb->nextPtr)
+	{
+		p_tab[num].taskId   = p_tcb->traceId;
+		p_tab[num].priority = (u8)p_tcb->basePriority;
+		p_tab[num].reserved = 0;
+		for(i = 0; i < OS_TRACE_NAME_LEN - 1 && p_tcb->taskName != NULL && p_tcb->taskName[i] != '\0'; i++)
+		{
+			p_tab[num].name[i] = p_tcb->taskName[i];
+		}
+		p_tab[num].name[i] = '\0';
+		num++;
+	}
+	OS_EXIT_CRITICAL();
+
+	return num;
+}
+
+#endif //OS_CFG_TRACE_EN